@@ -0,0 +1,518 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "FileTailWorker.h"
+
+#include "RotatedLogs.h"
+
+#include <QFileInfo>
+#include <QSocketNotifier>
+#include <QTimer>
+
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace {
+
+// Read granularity; peak memory per read stays near this plus maxLines
+constexpr qint64 kChunkSize = 64 * 1024;
+
+// Bytes kept from before filePos_ to recognise our data in a rotated copy
+constexpr qsizetype kSignatureBytes = 64;
+
+constexpr uint32_t kFileEvents = IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF;
+constexpr uint32_t kDirEvents  = IN_CREATE | IN_MOVED_TO;
+
+// How often a file followed through inotify is checked for growth nobody
+// told us about, and how many such checks in a row mean inotify is deaf
+constexpr int kSilenceCheckMs  = 5000;
+constexpr int kSilentChecks    = 2;
+
+bool fileId(const char* path, quint64& inode, quint64& device) {
+    struct stat st {};
+    if (::stat(path, &st) != 0) return false;
+    inode  = quint64(st.st_ino);
+    device = quint64(st.st_dev);
+    return true;
+}
+
+// Network and FUSE filesystems, where pages can change or vanish underneath
+// a mapping and inotify misses writes made elsewhere
+bool isNetworkType(unsigned long type) {
+    switch (type) {
+        case 0x6969UL:        // NFS
+        case 0x517BUL:        // SMB
+        case 0xFF534D42UL:    // CIFS
+        case 0xFE534D42UL:    // SMB2
+        case 0x65735546UL:    // FUSE
+        case 0x01021997UL:    // v9fs
+        case 0x47504653UL:    // GPFS
+        case 0x0BD00BD0UL:    // Lustre
+        case 0x73757245UL:    // Coda
+        case 0x5346414FUL:    // AFS
+        case 0x00C36400UL:    // Ceph
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Mapping such a file risks SIGBUS, so those stay on the read() path
+bool canMap(const QString& path) {
+    struct statfs st {};
+    if (::statfs(QFile::encodeName(path).constData(), &st) != 0) return false;
+    return !isNetworkType(static_cast<unsigned long>(st.f_type));
+}
+
+bool isNetworkFs(const QString& path) {
+    struct statfs st {};
+    if (::statfs(QFile::encodeName(path).constData(), &st) != 0) return false;
+    return isNetworkType(static_cast<unsigned long>(st.f_type));
+}
+
+}  // namespace
+
+FileTailWorker::FileTailWorker(QObject* parent) : QObject(parent) {}
+
+FileTailWorker::~FileTailWorker() { stop(); }
+
+void FileTailWorker::start(const QString& path, int maxLines, int flushMs) {
+    stop();
+    path_     = path;
+    maxLines_ = maxLines;
+    flushMs_  = flushMs;
+
+    // Created here so the notifier and timer belong to this (worker) thread
+    drainTimer_ = new QTimer(this);
+    drainTimer_->setSingleShot(true);
+    connect(drainTimer_, &QTimer::timeout, this, &FileTailWorker::drain);
+
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) {
+        emit failed(QString("inotify unavailable: %1")
+                        .arg(QString::fromLocal8Bit(std::strerror(errno))));
+        return;
+    }
+    notifier_ = new QSocketNotifier(inotifyFd_, QSocketNotifier::Read, this);
+    connect(notifier_, &QSocketNotifier::activated, this, &FileTailWorker::onInotify);
+
+    // The directory watch lets us pick the file up if it is created later
+    const QString dir = QFileInfo(path_).absolutePath();
+    dirWd_ = inotify_add_watch(inotifyFd_, QFile::encodeName(dir).constData(), kDirEvents);
+
+    // Checked on the directory, so it works before the file exists
+    if (isNetworkFs(dir)) {
+        startPolling("network filesystem");
+    } else {
+        silenceTimer_ = new QTimer(this);
+        silenceTimer_->setInterval(kSilenceCheckMs);
+        connect(silenceTimer_, &QTimer::timeout, this, &FileTailWorker::checkSilence);
+        silenceTimer_->start();
+    }
+
+    if (!openFile()) {
+        emit failed(QString("Cannot open: %1").arg(path_));
+        return;
+    }
+    watchFile();
+
+    // Seed with exactly the last maxLines lines: scan back from EOF counting
+    // newlines so only the bytes that will be shown get decoded
+    LineBatch lines = readTail(file_, 0, file_.size());
+    const qsizetype seeded = lines.size();
+    deliver(lines);
+
+    // The live seed is out first; older lines follow for the view to put in
+    // front, however long the rotated chain takes to read
+    if (stitchRotated_ && seeded < maxLines_) {
+        LineBatch older = rotatedHistory(seeded);
+        if (!older.isEmpty()) {
+            if (counters_) {
+                IngestCounters::add(counters_->lines, older.size());
+                IngestCounters::add(counters_->bytes, older.data.size());
+            }
+            emit historyReady(older);
+        }
+    }
+}
+
+LineBatch FileTailWorker::rotatedHistory(qsizetype have) {
+    std::vector<std::pair<QString, LineBatch>> older;   // newest segment first
+    for (const QString& segment : rotatedSegments(path_)) {
+        if (have >= maxLines_) break;
+        LineBatch seg;
+        // Compressed segments have to be inflated front to back, so this is
+        // the slow part; it runs after the seed is emitted, on this thread
+        if (!readSegmentTail(segment, int(maxLines_ - have), filter_.get(), seg)) break;
+        have += seg.size();
+        older.emplace_back(QFileInfo(segment).fileName(), std::move(seg));
+    }
+    LineBatch stitched;
+    if (older.empty()) return stitched;
+
+    for (auto it = older.rbegin(); it != older.rend(); ++it) {
+        stitched.append(QByteArray("─── " + QFile::encodeName(it->first) + " ───"),
+                        Severity::Debug);
+        stitched.append(it->second);
+    }
+    stitched.append(QByteArray("─── " + QFile::encodeName(QFileInfo(path_).fileName()) + " ───"),
+                    Severity::Debug);
+    stitched.noticedNs = monotonicNs();
+    return stitched;
+}
+
+void FileTailWorker::stop() {
+    delete notifier_;
+    notifier_ = nullptr;
+    if (inotifyFd_ >= 0) {
+        ::close(inotifyFd_);   // drops all watches
+        inotifyFd_ = -1;
+    }
+    fileWd_ = dirWd_ = -1;
+    delete drainTimer_;
+    drainTimer_ = nullptr;
+    delete pollTimer_;
+    pollTimer_ = nullptr;
+    delete silenceTimer_;
+    silenceTimer_ = nullptr;
+    eventSeen_    = false;
+    silentChecks_ = 0;
+    file_.close();
+    inode_ = device_ = 0;
+    filePos_ = 0;
+    clearPartial();
+    lastBytes_.clear();
+}
+
+bool FileTailWorker::openFile() {
+    file_.close();
+    file_.setFileName(path_);
+    if (!file_.open(QFile::ReadOnly)) return false;
+
+    struct stat st {};
+    if (::fstat(file_.handle(), &st) == 0) {
+        inode_  = quint64(st.st_ino);
+        device_ = quint64(st.st_dev);
+    }
+    mappable_ = canMap(path_);
+    filePos_  = 0;
+    lastBytes_.clear();
+    return true;
+}
+
+void FileTailWorker::watchFile() {
+    if (fileWd_ >= 0) inotify_rm_watch(inotifyFd_, fileWd_);
+    fileWd_ = inotify_add_watch(inotifyFd_, QFile::encodeName(path_).constData(), kFileEvents);
+}
+
+void FileTailWorker::onInotify() {
+    alignas(inotify_event) char buf[4096];
+    const QByteArray name = QFile::encodeName(QFileInfo(path_).fileName());
+    bool relevant = false;
+
+    ssize_t n;
+    while ((n = ::read(inotifyFd_, buf, sizeof(buf))) > 0) {
+        for (char* p = buf; p < buf + n; ) {
+            const auto* ev = reinterpret_cast<const inotify_event*>(p);
+            if (ev->wd == fileWd_) {
+                relevant = true;
+                if (ev->mask & IN_IGNORED) fileWd_ = -1;   // inode gone; rewatched in drain()
+            } else if (ev->wd == dirWd_ && ev->len > 0 && name == ev->name) {
+                relevant = true;
+            }
+            p += sizeof(inotify_event) + ev->len;
+        }
+    }
+
+    if (relevant) eventSeen_ = true;
+    if (relevant && noticedNs_ == 0) noticedNs_ = monotonicNs();
+    if (relevant && !drainTimer_->isActive())
+        drainTimer_->start(flushMs_);
+}
+
+void FileTailWorker::drain() {
+    // Not opened yet (did not exist at start, or was deleted): wait for it
+    if (!file_.isOpen()) {
+        if (!openFile()) return;
+        watchFile();
+        emit rotated("recreated");
+        drainOpenFile();
+        return;
+    }
+
+    // Whatever happens to the path, everything written to our fd comes first
+    drainOpenFile();
+
+    quint64 inode = 0, device = 0;
+    const bool exists = fileId(QFile::encodeName(path_).constData(), inode, device);
+    if (exists && (inode != inode_ || device != device_)) {
+        // Renamed away and replaced (logrotate "create"): switch to the new file
+        flushPartial();
+        if (!openFile()) return;
+        watchFile();
+        emit rotated("renamed");
+        drainOpenFile();
+    } else if (!exists) {
+        // Deleted or moved with no replacement yet; the directory watch
+        // picks the file up again once it is recreated
+        flushPartial();
+        file_.close();
+    } else if (fileWd_ < 0) {
+        watchFile();
+    }
+}
+
+void FileTailWorker::startPolling(const QString& reason) {
+    if (pollTimer_) return;
+    if (silenceTimer_) silenceTimer_->deleteLater();   // may be what called us
+    silenceTimer_ = nullptr;
+
+    // inotify stays on as well: it still reports local writes at once
+    pollMs_    = qMax(flushMs_, kPollMinMs);
+    pollTimer_ = new QTimer(this);
+    pollTimer_->setSingleShot(true);
+    connect(pollTimer_, &QTimer::timeout, this, &FileTailWorker::poll);
+    pollTimer_->start(pollMs_);
+    emit pollingStarted(reason);
+}
+
+void FileTailWorker::poll() {
+    const qint64  pos   = filePos_;
+    const quint64 inode = inode_;
+    const bool    open  = file_.isOpen();
+    drain();
+
+    // Fast while data flows; each idle poll doubles the wait up to the cap,
+    // so an idle file costs a couple of stat calls every few seconds
+    const bool active = filePos_ != pos || inode_ != inode || file_.isOpen() != open;
+    pollMs_ = active ? qMax(flushMs_, kPollMinMs) : qMin(pollMs_ * 2, kPollMaxMs);
+    pollTimer_->start(pollMs_);
+}
+
+void FileTailWorker::checkSilence() {
+    // Unread data with no event since the last check, twice running: writes
+    // are arriving that inotify does not see (another host, or a mount type
+    // the filesystem check did not recognise)
+    const bool unread = file_.isOpen() && file_.size() != filePos_ && !drainTimer_->isActive();
+    silentChecks_ = unread && !eventSeen_ ? silentChecks_ + 1 : 0;
+    eventSeen_    = false;
+    if (silentChecks_ >= kSilentChecks) startPolling("no inotify events while the file changed");
+}
+
+void FileTailWorker::drainOpenFile() {
+    const qint64 currentSize = file_.size();   // fstat on the open fd
+    if (currentSize < filePos_) {
+        // Same inode but shorter: truncated in place, by copytruncate if the
+        // copy next to it has the bytes we read last right before filePos_
+        const bool copied = recoverCopied();
+        filePos_ = 0;
+        clearPartial();
+        lastBytes_.clear();
+        emit rotated(copied ? "copytruncate" : "truncated");
+    }
+
+    if (filePos_ != currentSize) {
+        LineBatch lines = readTail(file_, filePos_, currentSize);
+        deliver(lines);
+    }
+}
+
+bool FileTailWorker::recoverCopied() {
+    if (lastBytes_.isEmpty()) return false;
+
+    QFile copy(path_ + ".1");
+    if (!copy.open(QFile::ReadOnly) || copy.size() < filePos_) return false;
+    if (!copy.seek(filePos_ - lastBytes_.size()) || copy.read(lastBytes_.size()) != lastBytes_)
+        return false;
+
+    // Lines written between our last read and the copy only exist there now
+    if (copy.size() > filePos_) {
+        LineBatch lines = readTail(copy, filePos_, copy.size());
+        deliver(lines);
+    }
+    flushPartial();
+    return true;
+}
+
+void FileTailWorker::flushPartial() {
+    if (partial_.isEmpty()) return;
+    LineBatch lines;
+    finishPartial(lines);
+    deliver(lines);
+}
+
+void FileTailWorker::deliver(LineBatch& lines) {
+    if (lines.isEmpty()) return;
+    lines.noticedNs = noticedNs_ > 0 ? noticedNs_ : monotonicNs();
+    noticedNs_ = 0;
+    if (counters_) {
+        IngestCounters::add(counters_->lines, lines.size());
+        IngestCounters::add(counters_->bytes, lines.data.size());
+        IngestCounters::add(counters_->inFlight, 1);
+    }
+    emit linesReady(lines);
+}
+
+qint64 FileTailWorker::timedRead(QFile& f, char* data, qint64 len) {
+    const qint64 t0 = monotonicNs();
+    const qint64 n  = f.read(data, len);
+    if (counters_) counters_->addRead(monotonicNs() - t0);
+    return n;
+}
+
+void FileTailWorker::rememberTail(const char* data, qsizetype n) {
+    if (n >= kSignatureBytes) {
+        lastBytes_ = QByteArray(data + n - kSignatureBytes, kSignatureBytes);
+    } else {
+        lastBytes_.append(data, n);
+        if (lastBytes_.size() > kSignatureBytes)
+            lastBytes_.remove(0, lastBytes_.size() - kSignatureBytes);
+    }
+}
+
+void FileTailWorker::splitLines(const char* p, const char* end, LineBatch& lines) {
+    const qint64 t0 = monotonicNs();
+    records_.clear();
+    const qsizetype tail = scanLines(p, end - p, records_);
+
+    size_t i = 0;
+    if (!partial_.isEmpty() && !records_.empty()) {
+        // The first line began in an earlier read; finish it and classify it whole
+        extendPartial(p, records_.front().offset + records_.front().length);
+        finishPartial(lines);
+        i = 1;
+    }
+    for (; i < records_.size(); ++i) {
+        const LineRecord& r = records_[i];
+        addLine(lines, QByteArrayView(p + r.offset, r.length), r.severity);
+    }
+    extendPartial(p + tail, end - p - tail);
+    if (counters_) IngestCounters::add(counters_->parseNs, monotonicNs() - t0);
+}
+
+void FileTailWorker::extendPartial(const char* data, qsizetype len) {
+    // One byte past the cap is enough for sanitizeLine() to cut the line;
+    // the rest is only counted, so a file without newlines costs no memory
+    const qsizetype room = qMax<qsizetype>(0, kMaxLineBytes + 1 - partial_.size());
+    partial_.append(data, qMin(len, room));
+    partialCut_ += qMax<qsizetype>(0, len - room);
+}
+
+void FileTailWorker::finishPartial(LineBatch& lines) {
+    const LineRecord r = makeRecord(partial_.constData(), 0, partial_.size());
+    addLine(lines, QByteArrayView(partial_).sliced(r.offset, r.length), r.severity, partialCut_);
+    clearPartial();
+}
+
+void FileTailWorker::clearPartial() {
+    partial_.clear();
+    partialCut_ = 0;
+}
+
+void FileTailWorker::addLine(LineBatch& lines, QByteArrayView line, Severity severity,
+                             qint64 cutBefore) const {
+    if (line.isEmpty()) return;
+    if (filter_ && !filter_->accepts(line, severity)) {
+        if (counters_) IngestCounters::add(counters_->filtered, 1);
+        return;
+    }
+    lines.append(line, severity, cutBefore);
+}
+
+qint64 FileTailWorker::tailStart(QFile& f, qint64 from, qint64 to, int lines) {
+    chunk_.resize(kChunkSize);
+    BackScan st;
+    qint64   pos = to;
+
+    while (pos > from) {
+        const qint64 len = qMin(kChunkSize, pos - from);
+        pos -= len;
+        if (!f.seek(pos) || timedRead(f, chunk_.data(), len) != len) return from;
+
+        const qint64 i = scanBack(chunk_.constData(), len, lines, st);
+        if (i >= 0) return pos + i;
+    }
+    return from;
+}
+
+LineBatch FileTailWorker::readLines(QFile& f, qint64 from, qint64 to) {
+    LineBatch lines;
+    chunk_.resize(kChunkSize);
+    if (!f.seek(from)) return lines;
+
+    qint64 pos = from;
+    while (pos < to) {
+        const qint64 n = timedRead(f, chunk_.data(), qMin(kChunkSize, to - pos));
+        if (n <= 0) break;
+        pos += n;
+        splitLines(chunk_.constData(), chunk_.constData() + n, lines);
+        rememberTail(chunk_.constData(), n);
+    }
+    filePos_ = pos;
+
+    // Keep only the last maxLines entries
+    lines.keepLast(maxLines_);
+    return lines;
+}
+
+LineBatch FileTailWorker::readTail(QFile& f, qint64 from, qint64 to) {
+    // Small deltas are cheaper through read() than through a fresh mapping
+    if (mappable_ && to - from > kChunkSize) {
+        const qint64 t0  = monotonicNs();
+        uchar*       map = f.map(from, to - from);
+        if (counters_) counters_->addRead(monotonicNs() - t0);
+        if (map) {
+            const char* data = reinterpret_cast<const char*>(map);
+            BackScan st;
+            const qint64 i     = scanBack(data, to - from, maxLines_, st);
+            const qint64 start = i < 0 ? 0 : i;
+            if (start > 0) clearPartial();   // its line was skipped
+
+            // In kChunkSize pieces like the read() path: records hold 32-bit
+            // offsets, and the span is the whole delta when it has few lines
+            LineBatch         lines;
+            const char* const end = data + (to - from);
+            for (const char* p = data + start; p < end; ) {
+                const char* next = p + qMin<qint64>(kChunkSize, end - p);
+                splitLines(p, next, lines);
+                p = next;
+            }
+            rememberTail(data, to - from);
+            f.unmap(map);
+            filePos_ = to;
+
+            lines.keepLast(maxLines_);
+            return lines;
+        }
+    }
+
+    // For a large burst only the last maxLines_ are kept (see keepLast()),
+    // so jump straight to them instead of parsing what would be dropped
+    qint64 start = from;
+    if (to - from > kChunkSize) {
+        start = tailStart(f, from, to, maxLines_);
+        if (start > from) {
+            clearPartial();     // its line was skipped
+            lastBytes_.clear();   // and the bytes before `start` were never read
+        }
+    }
+    return readLines(f, start, to);
+}
@@ -0,0 +1,163 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "IngestMetrics.h"
+#include "LineBatch.h"
+#include "LineFilter.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+class QSocketNotifier;
+class QTimer;
+
+// Reads a tailed file on a background thread. Lives on its own QThread, owns
+// the open file, offset and inotify watches, and hands finished line batches
+// through a direct connection to the source's thread-safe IngestQueue, so
+// no per-batch event crosses to the GUI thread.
+//
+// The file and its parent directory are watched with inotify. Rotation is
+// detected by comparing the inode and device behind the path with the open
+// fd: after a rename (logrotate "create") the old fd is drained to EOF
+// before switching to the new file, and after copytruncate the lines copied
+// away that were not read yet are recovered from "<path>.1".
+//
+// inotify never hears of writes made by other hosts on network filesystems.
+// On those, or once the file is seen growing with no events for a while,
+// the worker also polls fstat(): at the flush interval (kPollMinMs at the
+// least) while data flows, backing off exponentially to kPollMaxMs while
+// the file is idle.
+class FileTailWorker : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kPollMinMs = 100;
+    static constexpr int kPollMaxMs = 5000;
+
+    explicit FileTailWorker(QObject* parent = nullptr);
+    ~FileTailWorker() override;
+
+    // Lines the filter rejects are dropped before they are emitted. Set
+    // before start().
+    void setFilter(std::shared_ptr<const LineFilter> filter) { filter_ = std::move(filter); }
+    void setCounters(std::shared_ptr<IngestCounters> counters) { counters_ = std::move(counters); }
+    // When the file holds fewer than maxLines lines at start(), make up the
+    // rest from its rotated predecessors, see historyReady(). Set before
+    // start().
+    void setStitchRotated(bool on) { stitchRotated_ = on; }
+
+public slots:
+    void start(const QString& path, int maxLines, int flushMs);
+    void stop();
+
+signals:
+    void linesReady(const LineBatch& lines);
+    // Lines from the rotated predecessors, older than everything delivered
+    // so far; emitted once after the seed when stitching.
+    void historyReady(const LineBatch& lines);
+    // `how` is "truncated", "copytruncate", "renamed" or "recreated".
+    void rotated(const QString& how);
+    void failed(const QString& message);
+    // The worker started polling; `reason` says why, for display.
+    void pollingStarted(const QString& reason);
+
+private:
+    // inotify events only mark the file dirty; drain() runs once per flush
+    // interval and reads everything that arrived in between.
+    void onInotify();
+    void drain();
+    // Switches to polling, which stays on until stop().
+    void startPolling(const QString& reason);
+    void poll();
+    // Looks for unread data no event told us about.
+    void checkSilence();
+
+    bool openFile();
+    void watchFile();
+    // Reads whatever the open fd has beyond filePos_ and emits it.
+    void drainOpenFile();
+    // After a truncation, reads the unread tail of the copy at "<path>.1" if
+    // it is one. Returns true if this was a copytruncate.
+    bool recoverCopied();
+    // Emits a partial line left at the end of a file that will not grow.
+    void flushPartial();
+    // Stamps, counts and emits a batch if it has any lines.
+    void deliver(LineBatch& lines);
+    // Times one read(); returns its result.
+    qint64 timedRead(QFile& f, char* data, qint64 len);
+    // Keeps the last kSignatureBytes bytes read, for recoverCopied().
+    void rememberTail(const char* data, qsizetype n);
+    // Lines from <path>.1, <path>.2.gz, ... to make up the `have` lines of
+    // the seed to maxLines, oldest segment first, each behind a marker line
+    // and ending with one for the live file. Stops at the first segment
+    // that fills it up.
+    LineBatch rotatedHistory(qsizetype have);
+
+    // Reads the last maxLines lines of [from, to), through a memory mapping
+    // when the filesystem allows it and through chunked read() otherwise.
+    LineBatch readTail(QFile& f, qint64 from, qint64 to);
+    // Offset in [from, to) where the last `lines` complete lines begin,
+    // found by scanning backwards a chunk at a time.
+    qint64 tailStart(QFile& f, qint64 from, qint64 to, int lines);
+    // Reads [from, to) in fixed-size chunks, carrying an unterminated
+    // trailing line over in partial_. Advances filePos_ to `to`.
+    LineBatch readLines(QFile& f, qint64 from, qint64 to);
+
+    void splitLines(const char* p, const char* end, LineBatch& lines);
+    // Buffers the start of an unterminated line, up to just past kMaxLineBytes.
+    void extendPartial(const char* data, qsizetype len);
+    // Emits partial_ as a complete line and empties it.
+    void finishPartial(LineBatch& lines);
+    void clearPartial();
+    // Appends a trimmed line unless the filter rejects it.
+    void addLine(LineBatch& lines, QByteArrayView line, Severity severity,
+                 qint64 cutBefore = 0) const;
+
+    QString              path_;
+    QFile                file_;
+    quint64              inode_    = 0;
+    quint64              device_   = 0;
+    QByteArray           lastBytes_;        // up to 64 bytes before filePos_
+    int                  maxLines_ = 500;
+    int                  flushMs_  = 50;
+    qint64               filePos_  = 0;
+    bool                 mappable_ = false;
+    bool                 stitchRotated_ = false;
+    QByteArray           partial_;          // bytes after the last '\n' read
+    qint64               partialCut_ = 0;   // of those, bytes dropped past the cap
+    QByteArray           chunk_;            // reusable read buffer
+    std::vector<LineRecord> records_;       // scratch for scanLines()
+    std::shared_ptr<const LineFilter> filter_;
+    std::shared_ptr<IngestCounters>   counters_;
+    qint64               noticedNs_ = 0;    // first inotify event since the last delivery
+    int                  inotifyFd_ = -1;
+    int                  fileWd_    = -1;
+    int                  dirWd_     = -1;
+    QSocketNotifier*     notifier_  = nullptr;
+    QTimer*              drainTimer_ = nullptr;
+    QTimer*              pollTimer_  = nullptr;   // while polling
+    QTimer*              silenceTimer_ = nullptr; // while relying on inotify
+    int                  pollMs_     = 0;
+    bool                 eventSeen_  = false;     // since the last silence check
+    int                  silentChecks_ = 0;       // in a row, with unread data
+};
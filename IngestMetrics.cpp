@@ -0,0 +1,124 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "IngestMetrics.h"
+
+#include <bit>
+
+void IngestCounters::addRead(qint64 ns) {
+    add(reads, 1);
+    add(readNs, ns);
+    const int bucket = qMin(kLatencyBuckets - 1, int(std::bit_width(quint64(ns / 1000))));
+    add(readLatency[size_t(bucket)], 1);
+}
+
+IngestMetrics IngestSampler::sample(const IngestCounters& c, qint64 evictedTotal,
+                                    qint64 pendingLines, qint64 renderNsTotal,
+                                    qint64 latencyNs) {
+    const auto load = [](const std::atomic<qint64>& v) { return v.load(std::memory_order_relaxed); };
+    const qint64 now = monotonicNs();
+
+    IngestMetrics m;
+    const double secs = at_ > 0 ? double(now - at_) / 1e9 : 0.0;
+    if (secs > 0) {
+        m.linesPerSec = double(load(c.lines) - lines_) / secs;
+        m.bytesPerSec = double(load(c.bytes) - bytes_) / secs;
+        m.parseMs     = double(load(c.parseNs) - parseNs_) / 1e6 / secs;
+        m.renderMs    = double(renderNsTotal - renderNs_) / 1e6 / secs;
+    }
+    // The store's count restarts when it is cleared
+    m.evicted    = qMax<qint64>(0, evictedTotal - evicted_);
+    m.filtered   = load(c.filtered) - filtered_;
+    m.overflowed = load(c.overflowed) - overflow_;
+    m.reads      = load(c.reads) - reads_;
+    if (m.reads > 0) m.readAvgUs = double(load(c.readNs) - readNs_) / 1e3 / double(m.reads);
+    m.latencyMs  = latencyNs > 0 ? latencyNs / 1'000'000 : -1;
+    m.queueDepth = load(c.inFlight) + pendingLines;
+
+    // 99th percentile of this interval's reads, from the bucket deltas
+    std::array<qint64, IngestCounters::kLatencyBuckets> counts {};
+    for (size_t i = 0; i < counts.size(); ++i) counts[i] = load(c.readLatency[i]);
+    if (m.reads > 0) {
+        const qint64 threshold = m.reads - m.reads / 100;
+        qint64 seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i] - buckets_[i];
+            if (seen >= threshold) {
+                m.readP99Us = qint64(1) << i;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m.severities.size(); ++i) {
+        const qint64 total = load(c.severities[i]);
+        m.severities[i] = total - severities_[i];
+        severities_[i]  = total;
+    }
+
+    at_       = now;
+    lines_    = load(c.lines);
+    bytes_    = load(c.bytes);
+    filtered_ = load(c.filtered);
+    overflow_ = load(c.overflowed);
+    reads_    = load(c.reads);
+    readNs_   = load(c.readNs);
+    parseNs_  = load(c.parseNs);
+    evicted_  = evictedTotal;
+    renderNs_ = renderNsTotal;
+    buckets_  = counts;
+    return m;
+}
+
+QJsonObject IngestMetrics::toJson() const {
+    return {
+        {"linesPerSec", linesPerSec},
+        {"bytesPerSec", bytesPerSec},
+        {"evicted",     evicted},
+        {"filtered",    filtered},
+        {"overflowed",  overflowed},
+        {"reads",       reads},
+        {"readAvgUs",   readAvgUs},
+        {"readP99Us",   readP99Us},
+        {"parseMs",     parseMs},
+        {"renderMs",    renderMs},
+        {"latencyMs",   latencyMs},
+        {"queueDepth",  queueDepth},
+        {"severities",  QJsonObject{
+            {"plain",   severities[0]},
+            {"error",   severities[1]},
+            {"warning", severities[2]},
+            {"debug",   severities[3]},
+            {"info",    severities[4]},
+        }},
+    };
+}
+
+QString IngestMetrics::summary() const {
+    const QString rate = bytesPerSec >= 1024 * 1024
+        ? QString("%1 MB/s").arg(bytesPerSec / (1024 * 1024), 0, 'f', 1)
+        : QString("%1 KB/s").arg(bytesPerSec / 1024, 0, 'f', 1);
+    return QString("%1 l/s %2 · read %3µs p99<%4µs · parse %5 render %6 ms/s · lag %7 · q %8 · drop %9")
+        .arg(qRound64(linesPerSec))
+        .arg(rate)
+        .arg(qRound64(readAvgUs))
+        .arg(readP99Us)
+        .arg(parseMs, 0, 'f', 1)
+        .arg(renderMs, 0, 'f', 1)
+        .arg(latencyMs >= 0 ? QString("%1 ms").arg(latencyMs) : QString("–"))
+        .arg(queueDepth)
+        .arg(evicted + filtered + overflowed);
+}
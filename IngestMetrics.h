@@ -0,0 +1,102 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+// Monotonic clock shared by the reader threads and the GUI thread, in ns.
+inline qint64 monotonicNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Cumulative counters for one source, bumped by its reader threads and
+// sampled by the GUI thread. Each value stands alone, so relaxed atomics do.
+struct IngestCounters {
+    // Read call durations in power-of-two buckets: bucket i holds calls
+    // shorter than 2^i µs, the last one everything longer
+    static constexpr int kLatencyBuckets = 16;
+    static constexpr int kSeverities     = 5;    // one per Severity value
+
+    std::atomic<qint64> lines      {0};   // delivered by the readers
+    std::atomic<qint64> bytes      {0};
+    std::atomic<qint64> filtered   {0};   // rejected by a source filter
+    std::atomic<qint64> overflowed {0};   // dropped before reaching the store
+    std::atomic<qint64> reads      {0};
+    std::atomic<qint64> readNs     {0};
+    std::atomic<qint64> parseNs    {0};   // line splitting and classification
+    std::atomic<qint64> inFlight   {0};   // batches queued between threads
+    std::array<std::atomic<qint64>, kLatencyBuckets> readLatency {};
+    std::array<std::atomic<qint64>, kSeverities> severities {};   // queued lines by Severity
+
+    static void add(std::atomic<qint64>& counter, qint64 n) {
+        counter.fetch_add(n, std::memory_order_relaxed);
+    }
+    void addRead(qint64 ns);
+};
+
+// A source's activity over one sampling interval plus the view's own
+// render cost: what the header overlay shows and what the widget reports.
+struct IngestMetrics {
+    double linesPerSec  = 0;
+    double bytesPerSec  = 0;
+    qint64 evicted      = 0;    // counts within the interval
+    qint64 filtered     = 0;
+    qint64 overflowed   = 0;
+    qint64 reads        = 0;
+    double readAvgUs    = 0;
+    qint64 readP99Us    = 0;    // bucket upper bound
+    double parseMs      = 0;    // per second of wall time
+    double renderMs     = 0;
+    qint64 latencyMs    = -1;   // change noticed to painted, worst case; -1 = none
+    qint64 queueDepth   = 0;    // batches in flight plus lines awaiting a flush
+    std::array<qint64, IngestCounters::kSeverities> severities {};   // indexed by Severity
+
+    QJsonObject toJson() const;
+    // One line for the header bar.
+    QString     summary() const;
+};
+
+// Turns cumulative counters into per-interval metrics.
+class IngestSampler {
+public:
+    void reset() { *this = IngestSampler(); }
+
+    // `evictedTotal` and `renderNsTotal` are cumulative like the counters.
+    IngestMetrics sample(const IngestCounters& counters, qint64 evictedTotal,
+                         qint64 pendingLines, qint64 renderNsTotal, qint64 latencyNs);
+
+private:
+    qint64 at_       = 0;
+    qint64 lines_    = 0;
+    qint64 bytes_    = 0;
+    qint64 filtered_ = 0;
+    qint64 overflow_ = 0;
+    qint64 reads_    = 0;
+    qint64 readNs_   = 0;
+    qint64 parseNs_  = 0;
+    qint64 evicted_  = 0;
+    qint64 renderNs_ = 0;
+    std::array<qint64, IngestCounters::kLatencyBuckets> buckets_ {};
+    std::array<qint64, IngestCounters::kSeverities>     severities_ {};
+};
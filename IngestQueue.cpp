@@ -0,0 +1,103 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "IngestQueue.h"
+
+#include <QMutexLocker>
+
+#include <utility>
+
+void IngestQueue::setCapacity(qsizetype lines) {
+    QMutexLocker locker(&mutex_);
+    capacity_ = qMax<qsizetype>(1, lines);
+}
+
+void IngestQueue::setPolicy(Policy policy) {
+    QMutexLocker locker(&mutex_);
+    policy_ = policy;
+}
+
+IngestQueue::PushResult IngestQueue::push(const LineBatch& lines) {
+    PushResult result;
+    if (lines.isEmpty()) return result;
+
+    QMutexLocker locker(&mutex_);
+    const qsizetype room = capacity_ - queue_.size();
+    if (lines.size() <= room) {
+        queue_.append(lines);
+    } else {
+        switch (policy_) {
+            case Policy::DropOldest:
+                queue_.append(lines);
+                break;
+            case Policy::Sample: {
+                // Whatever still fits goes in whole; the excess is thinned out
+                LineBatch kept;
+                kept.noticedNs = lines.noticedNs;
+                for (qsizetype i = 0; i < lines.size(); ++i) {
+                    if (i < room || sampled_++ % kSampleEvery == 0)
+                        kept.append(lines.line(i), lines.severity(i));
+                    else
+                        ++result.shed;
+                }
+                queue_.append(kept);
+                break;
+            }
+            case Policy::Collapse: {
+                LineBatch kept;
+                kept.noticedNs = lines.noticedNs;
+                for (qsizetype i = 0; i < qMax<qsizetype>(0, room); ++i)
+                    kept.append(lines.line(i), lines.severity(i));
+                queue_.append(kept);
+                skipped_     += lines.size() - kept.size();
+                result.shed  += lines.size() - kept.size();
+                break;
+            }
+        }
+        // Past the capacity only the newest lines are kept, whatever the policy
+        result.shed += qMax<qsizetype>(0, queue_.size() - capacity_);
+        queue_.keepLast(capacity_);
+    }
+    result.wake = !std::exchange(woken_, true);
+    return result;
+}
+
+void IngestQueue::appendSkipped() {
+    queue_.append(QByteArray("─── ") + QByteArray::number(skipped_) +
+                      " lines skipped (input too fast) ───",
+                  Severity::Warning);
+    skipped_ = 0;
+}
+
+LineBatch IngestQueue::take() {
+    QMutexLocker locker(&mutex_);
+    // The skipped lines arrived after everything still queued
+    if (skipped_ > 0) appendSkipped();
+    woken_ = false;
+    return std::exchange(queue_, {});
+}
+
+qsizetype IngestQueue::size() const {
+    QMutexLocker locker(&mutex_);
+    return queue_.size();
+}
+
+void IngestQueue::clear() {
+    QMutexLocker locker(&mutex_);
+    queue_.clear();
+    skipped_ = 0;
+    woken_   = false;
+}
@@ -0,0 +1,64 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "LineBatch.h"
+
+#include <QMutex>
+
+// Bounded hand-off between the reader threads and the GUI thread. Readers
+// push from their own threads and wake the consumer at most once per
+// flush, so Qt's event queue never holds more than one event per source;
+// the GUI thread takes everything at the next flush. When a push would
+// exceed the capacity the overload policy decides what gives, which keeps
+// both memory and the latency to the newest line bounded however fast
+// lines arrive.
+class IngestQueue {
+public:
+    enum class Policy {
+        DropOldest,   // keep the newest lines
+        Sample,       // keep every kSampleEvery-th new line, then the newest
+        Collapse,     // keep what is queued, replace the rest by one marker
+    };
+    static constexpr int kSampleEvery = 10;
+
+    void   setCapacity(qsizetype lines);
+    void   setPolicy(Policy policy);
+    Policy policy() const { return policy_; }
+
+    struct PushResult {
+        qsizetype shed = 0;      // lines dropped, sampled away or collapsed
+        bool      wake = false;  // first push since the last take()
+    };
+    PushResult push(const LineBatch& lines);
+
+    // Everything queued, plus a "lines skipped" marker if some were collapsed.
+    LineBatch take();
+    qsizetype size() const;
+    void      clear();
+
+private:
+    void appendSkipped();
+
+    mutable QMutex mutex_;
+    LineBatch      queue_;
+    qsizetype      capacity_ = 500;
+    Policy         policy_   = Policy::DropOldest;
+    quint64        sampled_  = 0;       // lines seen by the sampler
+    qint64         skipped_  = 0;       // collapsed since the last marker
+    bool           woken_    = false;   // consumer already woken
+};
@@ -0,0 +1,243 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "JournalReader.h"
+
+#include <QDateTime>
+#include <QSocketNotifier>
+#include <QTimer>
+
+#include <systemd/sd-journal.h>
+
+#include <cstring>
+#include <ctime>
+#include <limits>
+
+namespace {
+
+// Matches `journalctl -n 50` in the subprocess fallback
+constexpr int kSeedEntries = 50;
+
+// Larger fields are truncated by libsystemd before they reach us
+constexpr size_t kFieldLimit = 64 * 1024;
+
+Severity severityForPriority(int priority) {
+    switch (priority) {
+        case 0: case 1: case 2: case 3: return Severity::Error;   // emerg..err
+        case 4:                         return Severity::Warning;
+        case 5: case 6:                 return Severity::Info;    // notice, info
+        case 7:                         return Severity::Debug;
+        default:                        return Severity::Plain;
+    }
+}
+
+// journalctl -u appends ".service" to bare unit names
+QByteArray unitName(const QString& unit) {
+    QByteArray name = unit.toUtf8();
+    if (!name.contains('.')) name.append(".service");
+    return name;
+}
+
+}  // namespace
+
+JournalReader::JournalReader(QObject* parent) : QObject(parent) {}
+
+JournalReader::~JournalReader() { stop(); }
+
+void JournalReader::start(const QString& unit, int maxLines, int flushMs) {
+    stop();
+    maxLines_ = maxLines;
+    flushMs_  = flushMs;
+
+    if (sd_journal_open(&journal_, SD_JOURNAL_LOCAL_ONLY) < 0) {
+        journal_ = nullptr;
+        emit unavailable();
+        return;
+    }
+    sd_journal_set_data_threshold(journal_, kFieldLimit);
+
+    if (!unit.isEmpty()) {
+        // Messages from the unit itself, plus systemd's messages about it
+        const QByteArray name = unitName(unit);
+        const QByteArray own  = "_SYSTEMD_UNIT=" + name;
+        const QByteArray about = "UNIT=" + name;
+        sd_journal_add_match(journal_, own.constData(), size_t(own.size()));
+        sd_journal_add_disjunction(journal_);
+        sd_journal_add_match(journal_, about.constData(), size_t(about.size()));
+    }
+
+    // Matches on one field are ORed; the conjunction ANDs them with the unit
+    const int maxPriority = filter_ ? filter_->maxPriority() : -1;
+    if (maxPriority >= 0) {
+        if (!unit.isEmpty()) sd_journal_add_conjunction(journal_);
+        for (int priority = 0; priority <= maxPriority; ++priority) {
+            const QByteArray match = "PRIORITY=" + QByteArray::number(priority);
+            sd_journal_add_match(journal_, match.constData(), size_t(match.size()));
+        }
+    }
+
+    const int fd = sd_journal_get_fd(journal_);
+    if (fd < 0) {
+        sd_journal_close(journal_);
+        journal_ = nullptr;
+        emit unavailable();
+        return;
+    }
+
+    // Position before the last kSeedEntries entries so drain() seeds with them
+    sd_journal_seek_tail(journal_);
+    if (sd_journal_previous_skip(journal_, kSeedEntries + 1) <= kSeedEntries)
+        sd_journal_seek_head(journal_);
+
+    drainTimer_ = new QTimer(this);
+    drainTimer_->setSingleShot(true);
+    connect(drainTimer_, &QTimer::timeout, this, &JournalReader::drain);
+
+    wakeTimer_ = new QTimer(this);
+    wakeTimer_->setSingleShot(true);
+    connect(wakeTimer_, &QTimer::timeout, this, &JournalReader::onJournalReady);
+
+    notifier_ = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    connect(notifier_, &QSocketNotifier::activated, this, &JournalReader::onJournalReady);
+
+    drain();
+    scheduleTimeout();
+}
+
+void JournalReader::stop() {
+    delete notifier_;
+    notifier_ = nullptr;
+    delete drainTimer_;
+    drainTimer_ = nullptr;
+    delete wakeTimer_;
+    wakeTimer_ = nullptr;
+    if (journal_) {
+        sd_journal_close(journal_);
+        journal_ = nullptr;
+    }
+}
+
+void JournalReader::onJournalReady() {
+    // Acknowledges the wakeup; anything but NOP means new entries or files
+    if (sd_journal_process(journal_) != SD_JOURNAL_NOP) {
+        if (noticedNs_ == 0) noticedNs_ = monotonicNs();
+        if (!drainTimer_->isActive()) drainTimer_->start(flushMs_);
+    }
+    scheduleTimeout();
+}
+
+void JournalReader::scheduleTimeout() {
+    uint64_t usec = 0;
+    if (sd_journal_get_timeout(journal_, &usec) < 0 ||
+        usec == std::numeric_limits<uint64_t>::max()) {
+        wakeTimer_->stop();
+        return;
+    }
+    // usec is an absolute CLOCK_MONOTONIC deadline
+    struct timespec now {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const uint64_t nowUsec = uint64_t(now.tv_sec) * 1000000 + uint64_t(now.tv_nsec) / 1000;
+    const uint64_t waitMs  = usec > nowUsec ? (usec - nowUsec + 999) / 1000 : 0;
+    wakeTimer_->start(int(qMin<uint64_t>(waitMs, 60 * 1000)));
+}
+
+void JournalReader::drain() {
+    // Reading and formatting entries are one cost here, counted as one read
+    const qint64 t0 = monotonicNs();
+    LineBatch lines;
+    qint64    cut = 0;
+    while (sd_journal_next(journal_) > 0) {
+        appendEntry(lines);
+        // Only the newest maxLines can be shown; keep the batch bounded
+        if (lines.size() > 2 * maxLines_) {
+            cut += lines.size() - maxLines_;
+            lines.keepLast(maxLines_);
+        }
+    }
+    cut += qMax<qsizetype>(0, lines.size() - maxLines_);
+    lines.keepLast(maxLines_);
+    lines.noticedNs = noticedNs_ > 0 ? noticedNs_ : t0;
+    noticedNs_ = 0;
+
+    if (counters_) {
+        counters_->addRead(monotonicNs() - t0);
+        IngestCounters::add(counters_->lines, lines.size());
+        IngestCounters::add(counters_->bytes, lines.data.size());
+        IngestCounters::add(counters_->overflowed, cut);
+        if (!lines.isEmpty()) IngestCounters::add(counters_->inFlight, 1);
+    }
+    if (!lines.isEmpty()) emit linesReady(lines);
+}
+
+bool JournalReader::appendField(const char* field) {
+    const void* data = nullptr;
+    size_t      len  = 0;
+    if (sd_journal_get_data(journal_, field, &data, &len) < 0) return false;
+
+    // Data comes back as "FIELD=value" and is only valid until the next call
+    const size_t prefix = std::strlen(field) + 1;
+    if (len < prefix) return false;
+    line_.append(static_cast<const char*>(data) + prefix, qsizetype(len - prefix));
+    return true;
+}
+
+void JournalReader::appendEntry(LineBatch& lines) {
+    // Severity from PRIORITY when present, otherwise guessed from the text
+    line_.clear();
+    int priority = -1;
+    if (appendField("PRIORITY") && line_.size() == 1 && line_[0] >= '0' && line_[0] <= '7')
+        priority = line_[0] - '0';
+
+    // Same layout as journalctl --output=short-iso
+    line_.clear();
+    uint64_t usec = 0;
+    if (sd_journal_get_realtime_usec(journal_, &usec) >= 0) {
+        const QDateTime ts = QDateTime::fromMSecsSinceEpoch(qint64(usec / 1000));
+        line_.append(ts.toString(Qt::ISODate).toLatin1());
+        line_.append(' ');
+    }
+    if (appendField("_HOSTNAME")) line_.append(' ');
+    if (!appendField("SYSLOG_IDENTIFIER")) appendField("_COMM");
+    const qsizetype beforePid = line_.size();
+    line_.append('[');
+    if (appendField("_PID")) line_.append(']');
+    else                     line_.truncate(beforePid);
+    line_.append(": ");
+    appendField("MESSAGE");
+
+    if (filter_ && !filter_->accepts(line_, priority < 0 ? classifyLine(line_)
+                                                         : severityForPriority(priority))) {
+        if (counters_) IngestCounters::add(counters_->filtered, 1);
+        return;
+    }
+
+    // Multi-line messages become one row per line, all with the entry's severity
+    const QByteArrayView entry(line_);
+    qsizetype begin = 0;
+    while (begin <= entry.size()) {
+        qsizetype end = entry.indexOf('\n', begin);
+        if (end < 0) end = entry.size();
+        const QByteArrayView part = entry.sliced(begin, end - begin);
+        if (priority < 0) {
+            lines.append(part);
+        } else {
+            const LineRecord r = makeRecord(part.data(), 0, part.size());
+            if (r.length > 0)
+                lines.append(part.sliced(r.offset, r.length), severityForPriority(priority));
+        }
+        begin = end + 1;
+    }
+}
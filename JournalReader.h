@@ -0,0 +1,77 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "IngestMetrics.h"
+#include "LineBatch.h"
+#include "LineFilter.h"
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+
+#include <memory>
+
+class QSocketNotifier;
+class QTimer;
+struct sd_journal;
+
+// Reads the systemd journal through libsystemd instead of a journalctl
+// subprocess. Lives on its own QThread like FileTailWorker; the journal fd is
+// watched with a QSocketNotifier and new entries are drained once per flush
+// interval. Severity comes from the PRIORITY field rather than the text.
+class JournalReader : public QObject {
+    Q_OBJECT
+
+public:
+    explicit JournalReader(QObject* parent = nullptr);
+    ~JournalReader() override;
+
+    // The severity threshold becomes PRIORITY matches, so rejected entries
+    // are never read; other entries are checked once formatted. Set before
+    // start().
+    void setFilter(std::shared_ptr<const LineFilter> filter) { filter_ = std::move(filter); }
+    void setCounters(std::shared_ptr<IngestCounters> counters) { counters_ = std::move(counters); }
+
+public slots:
+    void start(const QString& unit, int maxLines, int flushMs);
+    void stop();
+
+signals:
+    void linesReady(const LineBatch& lines);
+    // The journal could not be opened; the caller should fall back to journalctl.
+    void unavailable();
+
+private:
+    void onJournalReady();
+    void drain();
+    void appendEntry(LineBatch& lines);
+    // Appends the value of `field` in the current entry to line_.
+    bool appendField(const char* field);
+    void scheduleTimeout();
+
+    sd_journal*       journal_     = nullptr;
+    QSocketNotifier*  notifier_    = nullptr;
+    QTimer*           drainTimer_  = nullptr;
+    QTimer*           wakeTimer_   = nullptr;   // for journals whose fd is not pollable
+    int               maxLines_    = 500;
+    int               flushMs_     = 50;
+    QByteArray        line_;                    // scratch for one formatted entry
+    std::shared_ptr<const LineFilter> filter_;
+    std::shared_ptr<IngestCounters>   counters_;
+    qint64            noticedNs_   = 0;         // first wakeup since the last drain
+};
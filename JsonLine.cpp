@@ -0,0 +1,310 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "JsonLine.h"
+
+#include <QDateTime>
+
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+// Level fields sit near the front in every logger we have seen
+constexpr qsizetype kJsonHeadBytes = 512;
+// Column widths in characters; times are shown as 2026-10-14 12:00:00.123
+constexpr int kTimeWidth  = 23;
+constexpr int kLevelWidth = 5;
+
+constexpr std::string_view kTimeKeys[]    = {"ts", "time", "timestamp", "@timestamp", "date"};
+constexpr std::string_view kLevelKeys[]   = {"level", "lvl", "severity", "loglevel", "log.level"};
+constexpr std::string_view kMessageKeys[] = {"msg", "message", "@message"};
+
+constexpr bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+template <size_t N>
+bool isOneOf(QByteArrayView key, const std::string_view (&names)[N]) {
+    for (std::string_view name : names) {
+        if (qstrnicmp(key.data(), key.size(), name.data(), qsizetype(name.size())) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Integer value of a number or numeric string, or -1
+int levelNumber(QByteArrayView value) {
+    if (value.isEmpty() || value.size() > 4) return -1;
+    int n = 0;
+    for (char c : value) {
+        if (c < '0' || c > '9') return -1;
+        n = n * 10 + (c - '0');
+    }
+    return n;
+}
+
+QString levelName(Severity severity) {
+    switch (severity) {
+        case Severity::Error:   return QStringLiteral("ERROR");
+        case Severity::Warning: return QStringLiteral("WARN");
+        case Severity::Debug:   return QStringLiteral("DEBUG");
+        case Severity::Info:    return QStringLiteral("INFO");
+        default:                return {};
+    }
+}
+
+// Epoch numbers are told apart by magnitude: s, ms, µs or ns
+QString formatTime(const JsonField& field) {
+    if (field.string) {
+        QString text = jsonUnescape(field.value);
+        if (text.size() > 10 && text[10] == QLatin1Char('T')) text[10] = QLatin1Char(' ');
+        return text;
+    }
+    char buf[32];
+    if (field.value.size() >= qsizetype(sizeof buf)) return QString::fromUtf8(field.value);
+    std::memcpy(buf, field.value.data(), size_t(field.value.size()));
+    buf[field.value.size()] = '\0';
+    char*  end = nullptr;
+    double v   = std::strtod(buf, &end);
+    if (end == buf || v <= 0) return QString::fromUtf8(field.value);
+    if      (v < 1e11) v *= 1e3;
+    else if (v < 1e14) ;
+    else if (v < 1e17) v /= 1e3;
+    else               v /= 1e6;
+    return QDateTime::fromMSecsSinceEpoch(qint64(v)).toString("yyyy-MM-dd HH:mm:ss.zzz");
+}
+
+QString fieldText(const JsonField& field) {
+    return field.string ? jsonUnescape(field.value) : QString::fromUtf8(field.value);
+}
+
+}  // namespace
+
+// ── JsonScanner ───────────────────────────────────────────────────────────────
+
+JsonScanner::JsonScanner(QByteArrayView line, qsizetype limit)
+    : data_(line.data()), end_(limit < 0 ? line.size() : qMin(limit, line.size())) {
+    skipSpace();
+    if (pos_ < end_ && data_[pos_] == '{') ++pos_;
+    else                                   done_ = true;
+}
+
+bool JsonScanner::looksLikeObject(QByteArrayView line) {
+    return !line.isEmpty() && line.front() == '{';
+}
+
+void JsonScanner::skipSpace() {
+    while (pos_ < end_ && isSpace(data_[pos_])) ++pos_;
+}
+
+bool JsonScanner::scanString(QByteArrayView& out) {
+    const qsizetype begin = ++pos_;
+    while (pos_ < end_) {
+        const char c = data_[pos_];
+        if (c == '\\') {
+            pos_ += 2;
+        } else if (c == '"') {
+            out = QByteArrayView(data_ + begin, pos_ - begin);
+            ++pos_;
+            return true;
+        } else {
+            ++pos_;
+        }
+    }
+    return false;
+}
+
+bool JsonScanner::scanValue(JsonField& field) {
+    skipSpace();
+    if (pos_ >= end_) return false;
+    field.string = data_[pos_] == '"';
+    if (field.string) return scanString(field.value);
+
+    const qsizetype begin = pos_;
+    if (data_[pos_] == '{' || data_[pos_] == '[') {
+        int depth = 0;
+        while (pos_ < end_) {
+            const char c = data_[pos_];
+            if (c == '"') {
+                QByteArrayView skipped;
+                if (!scanString(skipped)) return false;
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                field.value = QByteArrayView(data_ + begin, ++pos_ - begin);
+                return true;
+            }
+            ++pos_;
+        }
+        return false;
+    }
+
+    // Number, true, false or null
+    while (pos_ < end_ && data_[pos_] != ',' && data_[pos_] != '}' && !isSpace(data_[pos_]))
+        ++pos_;
+    field.value = QByteArrayView(data_ + begin, pos_ - begin);
+    return !field.value.isEmpty();
+}
+
+bool JsonScanner::next(JsonField& field) {
+    if (done_) return false;
+    skipSpace();
+    // A '}' here ends the object
+    if (pos_ >= end_ || data_[pos_] != '"' || !scanString(field.key)) {
+        done_ = true;
+        return false;
+    }
+    skipSpace();
+    if (pos_ >= end_ || data_[pos_] != ':') {
+        done_ = true;
+        return false;
+    }
+    ++pos_;
+    if (!scanValue(field)) {
+        done_ = true;
+        return false;
+    }
+    skipSpace();
+    if (pos_ < end_ && data_[pos_] == ',') ++pos_;
+    else                                   done_ = true;
+    return true;
+}
+
+// ── Helpers ───────────────────────────────────────────────────────────────────
+
+QString jsonUnescape(QByteArrayView raw) {
+    if (!raw.contains('\\')) return QString::fromUtf8(raw);
+
+    QString out;
+    out.reserve(raw.size());
+    qsizetype run = 0;   // start of the unescaped bytes not copied yet
+    for (qsizetype i = 0; i < raw.size(); ++i) {
+        if (raw[i] != '\\' || i + 1 >= raw.size()) continue;
+        out += QString::fromUtf8(raw.sliced(run, i - run));
+        const char c = raw[++i];
+        switch (c) {
+            case 'n': out += QLatin1Char('\n'); break;
+            case 't': out += QLatin1Char('\t'); break;
+            case 'r': out += QLatin1Char('\r'); break;
+            case 'b': out += QLatin1Char('\b'); break;
+            case 'f': out += QLatin1Char('\f'); break;
+            case 'u': {
+                bool ok = false;
+                const ushort unit = i + 4 < raw.size()
+                    ? QByteArray(raw.sliced(i + 1, 4)).toUShort(&ok, 16) : 0;
+                if (ok) {
+                    out += QChar(unit);   // a surrogate pair arrives as two escapes
+                    i += 4;
+                }
+                break;
+            }
+            default:  out += QLatin1Char(c); break;   // \" \\ \/
+        }
+        run = i + 1;
+    }
+    out += QString::fromUtf8(raw.sliced(run));
+    return out;
+}
+
+Severity severityFromLevel(const JsonField& level) {
+    // pino/bunyan use 10..60, syslog priorities 0..7
+    if (const int n = levelNumber(level.value); n >= 0) {
+        if (n >= 10) {
+            return n >= 50 ? Severity::Error : n >= 40 ? Severity::Warning
+                 : n >= 30 ? Severity::Info  : Severity::Debug;
+        }
+        return n <= 3 ? Severity::Error : n == 4 ? Severity::Warning
+             : n <= 6 ? Severity::Info  : Severity::Debug;
+    }
+    if (!level.string) return Severity::Plain;
+
+    const Severity s = classifyKeywords(level.value);
+    if (s != Severity::Plain) return s;
+    // Short forms the keyword table does not carry
+    const QByteArrayView v = level.value;
+    if (v.startsWith("err") || v.startsWith("ERR") || v.startsWith("Err") ||
+        v.contains("panic") || v.contains("PANIC"))
+        return Severity::Error;
+    return Severity::Plain;
+}
+
+bool jsonLineSeverity(QByteArrayView line, Severity& severity) {
+    JsonScanner scanner(line, kJsonHeadBytes);
+    JsonField   field;
+    while (scanner.next(field)) {
+        if (!isOneOf(field.key, kLevelKeys)) continue;
+        severity = severityFromLevel(field);
+        return severity != Severity::Plain;
+    }
+    return false;
+}
+
+// ── JsonProjection ────────────────────────────────────────────────────────────
+
+JsonProjection::JsonProjection(const QStringList& extraKeys) {
+    for (const QString& key : extraKeys) {
+        const QByteArray k = key.trimmed().toUtf8();
+        if (!k.isEmpty()) extraKeys_.append(k);
+    }
+}
+
+bool JsonProjection::project(QByteArrayView line, Row& row) const {
+    if (!JsonScanner::looksLikeObject(line)) return false;
+
+    JsonField time, level, message, field;
+    QList<QString> extras(extraKeys_.size());
+    QList<bool>    found(extraKeys_.size(), false);
+    JsonScanner scanner(line);
+    while (scanner.next(field)) {
+        if (const qsizetype i = extraKeys_.indexOf(field.key); i >= 0) {
+            extras[i] = fieldText(field);
+            found[i]  = true;
+        } else if (time.key.isEmpty() && isOneOf(field.key, kTimeKeys)) {
+            time = field;
+        } else if (level.key.isEmpty() && isOneOf(field.key, kLevelKeys)) {
+            level = field;
+        } else if (message.key.isEmpty() && isOneOf(field.key, kMessageKeys)) {
+            message = field;
+        }
+    }
+    if (time.key.isEmpty() && level.key.isEmpty() && message.key.isEmpty()) return false;
+
+    QString levelText;
+    if (!level.key.isEmpty()) {
+        levelText = level.string ? jsonUnescape(level.value).toUpper()
+                                 : levelName(severityFromLevel(level));
+        if (levelText.isEmpty()) levelText = QString::fromUtf8(level.value);
+    }
+    row.head = (time.key.isEmpty() ? QString() : formatTime(time))
+                   .leftJustified(kTimeWidth, QLatin1Char(' '), true)
+             + QStringLiteral("  ") + levelText.leftJustified(kLevelWidth, QLatin1Char(' '), true)
+             + QStringLiteral("  ")
+             + (message.key.isEmpty() ? QString::fromUtf8(line) : fieldText(message));
+    // Rows are single lines; keep multi-line messages on one
+    row.head.replace(QLatin1Char('\n'), QLatin1Char(' ')).replace(QLatin1Char('\t'), QLatin1Char(' '));
+
+    row.extra.clear();
+    for (qsizetype i = 0; i < extraKeys_.size(); ++i) {
+        if (!found[i]) continue;
+        if (!row.extra.isEmpty()) row.extra += QStringLiteral("  ");
+        row.extra += QString::fromUtf8(extraKeys_[i]) + QLatin1Char('=') + extras[i];
+    }
+    return true;
+}
@@ -0,0 +1,90 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Severity.h"
+
+#include <QByteArrayView>
+#include <QString>
+#include <QStringList>
+
+// One top-level member of a JSON object line. Both views point into the
+// line; a string value is given without its quotes and still escaped.
+struct JsonField {
+    QByteArrayView key;
+    QByteArrayView value;
+    bool           string = false;
+};
+
+// Walks the top-level members of a single-line JSON object in one pass,
+// without allocating. Nested objects and arrays are skipped over and come
+// back as their raw text. Stops at the end of the object, or at the first
+// byte that does not fit, so a truncated line yields its leading members.
+class JsonScanner {
+public:
+    // `limit` caps how far into the line the scanner looks.
+    explicit JsonScanner(QByteArrayView line, qsizetype limit = -1);
+
+    // False once there are no more members.
+    bool next(JsonField& field);
+
+    static bool looksLikeObject(QByteArrayView line);
+
+private:
+    void skipSpace();
+    // Advances past a string whose opening quote is at pos_, returning its
+    // contents; false if it is not closed before end_.
+    bool scanString(QByteArrayView& out);
+    bool scanValue(JsonField& field);
+
+    const char* data_;
+    qsizetype   pos_ = 0;
+    qsizetype   end_;
+    bool        done_ = false;
+};
+
+// Decodes JSON string escapes (\n, \", \uXXXX with surrogate pairs, ...).
+QString jsonUnescape(QByteArrayView raw);
+
+// Severity named by a level field: a name such as "warn" or "ERROR", a
+// pino/bunyan number (10 trace … 60 fatal) or a syslog priority (0–7).
+// Plain if it means nothing recognisable.
+Severity severityFromLevel(const JsonField& level);
+
+// Severity from the level field ("level", "lvl", "severity", ...) of a JSON
+// object line, looked for in its first 512 bytes only. Returns false if
+// there is no recognisable one there.
+bool jsonLineSeverity(QByteArrayView line, Severity& severity);
+
+// Renders JSON object lines as fixed columns: time, level, message, then
+// the user-picked keys as key=value. Meant for the rows being painted, so
+// nothing is parsed at ingestion.
+class JsonProjection {
+public:
+    struct Row {
+        QString head;     // time, level and message
+        QString extra;    // picked keys
+    };
+
+    explicit JsonProjection(const QStringList& extraKeys = {});
+
+    // False if the line is not a JSON object; `row` is then untouched.
+    bool project(QByteArrayView line, Row& row) const;
+
+private:
+    QList<QByteArray> extraKeys_;
+};
@@ -0,0 +1,59 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "LineBatch.h"
+
+void LineBatch::append(QByteArrayView line) {
+    const LineRecord r = makeRecord(line.data(), 0, line.size());
+    if (r.length > 0) append(line.sliced(r.offset, r.length), r.severity);
+}
+
+void LineBatch::append(QByteArrayView line, Severity severity, qint64 cutBefore) {
+    QByteArray scratch;   // only allocated for lines that need escaping or cutting
+    line = sanitizeLine(line, scratch, cutBefore);
+    records.append({quint32(data.size()), quint32(line.size()), severity});
+    data.append(line.data(), line.size());
+}
+
+void LineBatch::append(const LineBatch& other) {
+    if (other.isEmpty()) return;
+    if (other.noticedNs > 0 && (noticedNs == 0 || other.noticedNs < noticedNs))
+        noticedNs = other.noticedNs;
+    const quint32 base = quint32(data.size());
+    data.append(other.data);
+    records.reserve(records.size() + other.records.size());
+    for (LineRecord r : other.records) {
+        r.offset += base;
+        records.append(r);
+    }
+}
+
+void LineBatch::keepLast(qsizetype n) {
+    const qsizetype drop = records.size() - n;
+    if (drop <= 0) return;
+
+    const quint32 cut = records[drop].offset;
+    data.remove(0, cut);
+    records.remove(0, drop);
+    for (LineRecord& r : records)
+        r.offset -= cut;
+}
+
+void LineBatch::clear() {
+    data.clear();
+    records.clear();
+    noticedNs = 0;
+}
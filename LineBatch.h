@@ -0,0 +1,58 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "LineScanner.h"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QMetaType>
+
+// A batch of complete lines as raw UTF-8, packed back to back in one buffer.
+// This is what readers hand to the display; nothing is decoded to UTF-16
+// until a row is actually painted. Lines go through sanitizeLine() on the
+// way in, so every stored line is valid UTF-8 of bounded length.
+struct LineBatch {
+    QByteArray        data;
+    QList<LineRecord> records;   // offsets into data
+    // monotonicNs() when the reader noticed the change these lines came
+    // from; the earliest one survives merging. 0 = unknown.
+    qint64            noticedNs = 0;
+
+    qsizetype size() const    { return records.size(); }
+    bool      isEmpty() const { return records.isEmpty(); }
+
+    QByteArrayView line(qsizetype i) const {
+        const LineRecord& r = records[i];
+        return QByteArrayView(data.constData() + r.offset, r.length);
+    }
+    Severity severity(qsizetype i) const { return records[i].severity; }
+
+    // Adds one line with surrounding whitespace trimmed and classifies it;
+    // blank lines are dropped.
+    void append(QByteArrayView line);
+    // Adds a line that is already trimmed and classified. `cutBefore` counts
+    // bytes of it the reader already dropped, for the note sanitizeLine() adds.
+    void append(QByteArrayView line, Severity severity, qint64 cutBefore = 0);
+    void append(const LineBatch& other);
+    // Drops all but the last n lines.
+    void keepLast(qsizetype n);
+    void clear();
+};
+
+Q_DECLARE_METATYPE(LineBatch)
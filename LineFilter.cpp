@@ -0,0 +1,188 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "LineFilter.h"
+
+namespace {
+
+constexpr uchar fold(uchar c) {
+    return (c >= 'A' && c <= 'Z') ? uchar(c - 'A' + 'a') : c;
+}
+
+// Longest run of ASCII literal characters that every match of `pattern`
+// must contain, or empty if there is none worth searching for first. Only
+// top-level text counts, and alternation or inline flags disable it.
+QByteArray requiredLiteral(const QString& pattern) {
+    if (pattern.contains(QLatin1Char('|')) || pattern.contains(QLatin1String("(?")))
+        return {};
+
+    QByteArray best, run;
+    int        depth = 0;
+    const auto flush = [&] {
+        if (run.size() > best.size()) best = run;
+        run.clear();
+    };
+    for (qsizetype i = 0; i < pattern.size(); ++i) {
+        const char16_t c = pattern[i].unicode();
+        switch (c) {
+            case '\\': {
+                const char16_t next = i + 1 < pattern.size() ? pattern[i + 1].unicode() : 0;
+                ++i;
+                // \. \[ and friends are literals; \d \w \b and the like are not
+                if (depth == 0 && next > ' ' && next < 0x80 && !QChar::isLetterOrNumber(next))
+                    run += char(next);
+                else
+                    flush();
+                break;
+            }
+            case '[':
+                flush();
+                // Skip the class; a ']' right after '[' or '[^' is part of it
+                for (++i; i < pattern.size(); ++i) {
+                    if (pattern[i] == QLatin1Char('\\')) ++i;
+                    else if (pattern[i] == QLatin1Char(']') && pattern[i - 1] != QLatin1Char('[') &&
+                             pattern[i - 1] != QLatin1Char('^'))
+                        break;
+                }
+                break;
+            case '(': flush(); ++depth; break;
+            case ')': flush(); --depth; break;
+            case '?': case '*': case '{':
+                // The character before may not be there at all
+                if (!run.isEmpty()) run.chop(1);
+                flush();
+                if (c == '{') i = qMax(i, pattern.indexOf(QLatin1Char('}'), i));
+                break;
+            case '+': case '.': case '^': case '$':
+                flush();
+                break;
+            default:
+                if (depth == 0 && c < 0x80) run += char(c);
+                else                        flush();
+                break;
+        }
+    }
+    flush();
+    return best.size() >= 3 ? best : QByteArray();
+}
+
+}  // namespace
+
+void LineFilter::Literal::set(const QByteArray& text, bool foldCase) {
+    needle = text;
+    folded = foldCase;
+    if (!folded) {
+        matcher.setPattern(needle);
+        return;
+    }
+    // Horspool over ASCII-folded bytes; the needle is already lower case
+    const qsizetype n = needle.size();
+    skip.fill(quint16(qMin<qsizetype>(n, 0xffff)));
+    for (qsizetype i = 0; i + 1 < n; ++i) {
+        const uchar c = uchar(needle[i]);
+        skip[c] = quint16(qMin<qsizetype>(n - 1 - i, 0xffff));
+        if (c >= 'a' && c <= 'z') skip[c - 'a' + 'A'] = skip[c];
+    }
+}
+
+bool LineFilter::Literal::findIn(QByteArrayView line) const {
+    if (!folded) return matcher.indexIn(line) >= 0;
+
+    const qsizetype n = needle.size();
+    const qsizetype m = line.size();
+    const auto*     h = reinterpret_cast<const uchar*>(line.data());
+    const auto*     p = reinterpret_cast<const uchar*>(needle.constData());
+
+    for (qsizetype pos = 0; pos + n <= m; ) {
+        const uchar last = h[pos + n - 1];
+        if (fold(last) == p[n - 1]) {
+            qsizetype i = 0;
+            while (i < n - 1 && fold(h[pos + i]) == p[i]) ++i;
+            if (i == n - 1) return true;
+        }
+        pos += skip[last];
+    }
+    return false;
+}
+
+LineFilter::LineFilter(const Spec& spec) : spec_(spec) {
+    if (spec_.pattern.isEmpty()) return;
+
+    foldCase_ = spec_.pattern == spec_.pattern.toLower();
+
+    if (spec_.regex) {
+        regex_.setPattern(spec_.pattern);
+        if (foldCase_) regex_.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+        valid_ = regex_.isValid();
+        if (!valid_) return;
+        regex_.optimize();
+        if (const QByteArray literal = requiredLiteral(spec_.pattern); !literal.isEmpty())
+            required_.set(literal, foldCase_);
+        return;
+    }
+
+    literal_.set(spec_.pattern.toUtf8(), foldCase_);
+}
+
+bool LineFilter::accepts(QByteArrayView line, Severity severity) const {
+    if (!valid_) return true;
+    if (severityLevel(severity) < spec_.minLevel) return false;
+    if (spec_.pattern.isEmpty()) return true;
+    return matchesPattern(line) != spec_.exclude;
+}
+
+int LineFilter::maxPriority() const {
+    if (!valid_) return -1;
+    switch (spec_.minLevel) {
+        case 1:  return 6;   // info and above
+        case 2:  return 4;   // warning
+        case 3:  return 3;   // err
+        default: return -1;
+    }
+}
+
+QString LineFilter::grepPattern() const {
+    if (!valid_ || spec_.pattern.isEmpty() || spec_.exclude) return {};
+    // journalctl --grep uses the same smart case rule
+    return spec_.regex ? spec_.pattern : QRegularExpression::escape(spec_.pattern);
+}
+
+bool LineFilter::matchesPattern(QByteArrayView line) const {
+    if (spec_.regex) {
+        // Most lines fail the byte search and are never decoded
+        if (!required_.needle.isEmpty() && !required_.findIn(line)) return false;
+        return regex_.match(QString::fromUtf8(line.data(), line.size())).hasMatch();
+    }
+    return literal_.findIn(line);
+}
+
+void LineFilter::matchSpans(QStringView text,
+                            QList<std::pair<qsizetype, qsizetype>>& out) const {
+    out.clear();
+    if (!valid_ || spec_.pattern.isEmpty()) return;
+
+    if (spec_.regex) {
+        for (auto it = regex_.globalMatch(text.toString()); it.hasNext(); ) {
+            const QRegularExpressionMatch m = it.next();
+            if (m.capturedLength() > 0) out.append({m.capturedStart(), m.capturedLength()});
+        }
+        return;
+    }
+    const Qt::CaseSensitivity cs = foldCase_ ? Qt::CaseInsensitive : Qt::CaseSensitive;
+    for (qsizetype pos = text.indexOf(spec_.pattern, 0, cs); pos >= 0;
+         pos = text.indexOf(spec_.pattern, pos + spec_.pattern.size(), cs))
+        out.append({pos, spec_.pattern.size()});
+}
@@ -0,0 +1,92 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Severity.h"
+
+#include <QByteArray>
+#include <QByteArrayMatcher>
+#include <QByteArrayView>
+#include <QRegularExpression>
+#include <QList>
+#include <QString>
+#include <QStringView>
+
+#include <array>
+#include <utility>
+
+// A line filter compiled once from the filter bar: a substring or regular
+// expression, optionally inverted, plus a minimum severity. Matching works
+// on raw UTF-8; plain substrings never decode the line. Smart case: a
+// pattern with no upper-case letters matches case-insensitively (ASCII
+// folding for substrings). A regular expression is only run on lines that
+// contain the longest literal every match needs, found with the same
+// substring search.
+// Immutable once built, so it can be shared with worker threads.
+class LineFilter {
+public:
+    struct Spec {
+        QString pattern;
+        bool    regex       = false;
+        bool    exclude     = false;   // hide matching lines instead
+        int     minLevel    = 0;       // severityLevel() threshold
+
+        bool operator==(const Spec&) const = default;
+    };
+
+    explicit LineFilter(const Spec& spec);
+
+    const Spec& spec() const { return spec_; }
+    // False for an invalid regular expression; such a filter matches everything.
+    bool isValid() const { return valid_; }
+    // True if the filter lets every line through.
+    bool isTrivial() const { return !valid_ || (spec_.pattern.isEmpty() && spec_.minLevel == 0); }
+
+    bool accepts(QByteArrayView line, Severity severity) const;
+
+    // Pushing the filter down to the journal: the highest syslog priority
+    // (0 = emerg .. 7 = debug) meeting the severity threshold, or -1 if all
+    // do; and the pattern as a PCRE for journalctl --grep, or empty if it
+    // cannot be expressed as one (no pattern, exclude, invalid regex).
+    int     maxPriority() const;
+    QString grepPattern() const;
+
+    // Where the pattern matches in decoded text, as (start, length) pairs in
+    // UTF-16 units; for highlighting the rows on screen. Ignores exclude.
+    void matchSpans(QStringView text, QList<std::pair<qsizetype, qsizetype>>& out) const;
+
+private:
+    // A substring searched in raw bytes, optionally with ASCII case folding
+    struct Literal {
+        QByteArray               needle;     // UTF-8, lower-cased when folding
+        bool                     folded = false;
+        QByteArrayMatcher        matcher;    // case-sensitive search
+        std::array<quint16, 256> skip {};    // Horspool shifts for folded search
+
+        void set(const QByteArray& text, bool foldCase);
+        bool findIn(QByteArrayView line) const;
+    };
+
+    bool matchesPattern(QByteArrayView line) const;
+
+    Spec                      spec_;
+    bool                      valid_      = true;
+    bool                      foldCase_   = false;
+    Literal                   literal_;            // a substring pattern
+    Literal                   required_;           // regex prefilter; empty if none
+    QRegularExpression        regex_;
+};
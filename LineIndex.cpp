@@ -0,0 +1,185 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "LineIndex.h"
+
+#include "Timestamp.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr quint32   kMagic     = 0x4c544958;   // "LTIX"
+constexpr quint32   kVersion   = 2;   // 2: unzoned stamps stored as UTC
+constexpr qsizetype kChunkSize = 1024 * 1024;
+constexpr qsizetype kHeadBytes = 4096;
+// Bytes at a line start handed to parseTimestamp()
+constexpr qsizetype kStampBytes = 64;
+// How often update() reports progress
+constexpr qint64    kProgressBytes = 64 * 1024 * 1024;
+
+quint64 headHash(QFile& f) {
+    if (!f.seek(0)) return 0;
+    const QByteArray head = f.read(kHeadBytes);
+    return qHash(head);
+}
+
+}  // namespace
+
+QString LineIndex::cachePath(const QString& path) {
+    const QFileInfo info(path);
+    const QString   canonical = info.canonicalFilePath();
+    const QByteArray id = QCryptographicHash::hash(
+        (canonical.isEmpty() ? info.absoluteFilePath() : canonical).toUtf8(),
+        QCryptographicHash::Sha1).toHex();
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                        + "/logtail";
+    return dir + "/" + QString::fromLatin1(id) + ".idx";
+}
+
+bool LineIndex::load(const QString& indexPath) {
+    QFile f(indexPath);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+    QDataStream in(&f);
+
+    quint32 magic = 0, version = 0;
+    quint64 offsets = 0, anchors = 0;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion) return false;
+    in >> inode_ >> device_ >> headHash_ >> size_ >> lines_ >> offsets >> anchors;
+    if (in.status() != QDataStream::Ok || offsets != quint64(lines_ / kStride + 1)) {
+        reset();
+        return false;
+    }
+
+    offsets_.resize(size_t(offsets));
+    for (qint64& o : offsets_) in >> o;
+    anchors_.resize(size_t(anchors));
+    for (Anchor& a : anchors_) in >> a.line >> a.ms;
+    if (in.status() != QDataStream::Ok) {
+        reset();
+        return false;
+    }
+    return true;
+}
+
+bool LineIndex::save(const QString& indexPath) const {
+    QDir().mkpath(QFileInfo(indexPath).absolutePath());
+    QSaveFile f(indexPath);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    QDataStream out(&f);
+
+    out << kMagic << kVersion << inode_ << device_ << headHash_ << size_ << lines_
+        << quint64(offsets_.size()) << quint64(anchors_.size());
+    for (qint64 o : offsets_) out << o;
+    for (const Anchor& a : anchors_) out << a.line << a.ms;
+    return out.status() == QDataStream::Ok && f.commit();
+}
+
+void LineIndex::reset() {
+    headHash_ = 0;
+    size_     = 0;
+    lines_    = 0;
+    offsets_.assign(1, 0);
+    anchors_.clear();
+}
+
+bool LineIndex::update(const QString& path, const std::atomic<bool>& cancel,
+                       const std::function<void(qint64, qint64)>& progress) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+
+    struct stat st {};
+    if (::fstat(f.handle(), &st) != 0) return false;
+    const qint64 end = qint64(st.st_size);
+
+    // A different inode, a shrunk file or a rewritten head means a new file.
+    // The head is only hashed once the file has that many bytes.
+    const quint64 head = end >= kHeadBytes ? headHash(f) : 0;
+    if (offsets_.empty() || quint64(st.st_ino) != inode_ || quint64(st.st_dev) != device_ ||
+        end < size_ || (headHash_ != 0 && head != headHash_)) {
+        reset();
+        inode_  = st.st_ino;
+        device_ = st.st_dev;
+    }
+    if (headHash_ == 0) headHash_ = head;
+
+    QByteArray    chunk(kChunkSize, Qt::Uninitialized);
+    qint64        pos          = size_;
+    qint64        lastProgress = pos;
+    // The last update may have stopped right at a block start
+    bool          wantAnchor   = lines_ % kStride == 0 &&
+                                 (anchors_.empty() || anchors_.back().line != lines_);
+
+    while (pos < end) {
+        if (cancel) return false;
+        const qint64 len = qMin<qint64>(kChunkSize, end - pos);
+        if (!f.seek(pos) || f.read(chunk.data(), len) != len) return false;
+        const char* data = chunk.constData();
+
+        for (qsizetype i = 0; i < len; ) {
+            if (wantAnchor) {
+                // Block start inside this chunk; stamps split across chunks are skipped
+                const QByteArrayView stamp(data + i, qMin<qsizetype>(kStampBytes, len - i));
+                const qint64 ms = parseTimestamp(stamp);
+                if (ms >= 0 && (anchors_.empty() || ms >= anchors_.back().ms))
+                    anchors_.push_back({lines_, ms});
+                wantAnchor = false;
+            }
+            const void* nl = std::memchr(data + i, '\n', size_t(len - i));
+            if (!nl) break;
+            i = static_cast<const char*>(nl) - data + 1;
+
+            ++lines_;
+            size_ = pos + i;
+            if (lines_ % kStride == 0) {
+                offsets_.push_back(size_);
+                wantAnchor = true;
+            }
+        }
+        pos += len;
+
+        if (progress && pos - lastProgress >= kProgressBytes) {
+            progress(pos, end);
+            lastProgress = pos;
+        }
+    }
+    if (progress) progress(end, end);
+    return true;
+}
+
+qint64 LineIndex::lineBefore(qint64 ms) const {
+    const auto it = std::upper_bound(anchors_.begin(), anchors_.end(), ms,
+                                     [](qint64 v, const Anchor& a) { return v < a.ms; });
+    return it == anchors_.begin() ? 0 : std::prev(it)->line;
+}
+
+qint64 LineIndex::lineAfter(qint64 ms) const {
+    const auto it = std::lower_bound(anchors_.begin(), anchors_.end(), ms,
+                                     [](const Anchor& a, qint64 v) { return a.ms < v; });
+    return it == anchors_.end() ? -1 : it->line;
+}
@@ -0,0 +1,75 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+// Sparse index of line starts in a log file, for scrolling back through
+// files far larger than the tail buffer. Records the offset of every
+// kStride-th line plus time anchors where the line at such a point has a
+// parseable timestamp, so any row or moment is at most kStride lines of
+// reading away. The index is cached under the cache directory, never next
+// to the log, and is extended incrementally while the file only grows.
+class LineIndex {
+public:
+    static constexpr qint64 kStride = 1024;
+
+    // Where the index for `path` is cached.
+    static QString cachePath(const QString& path);
+
+    // False if there is no cached index or it is unreadable.
+    bool load(const QString& indexPath);
+    bool save(const QString& indexPath) const;
+
+    // Indexes `path` from where the last update stopped to its current end,
+    // starting over if the file was replaced or truncated. `progress` gets
+    // (bytes indexed, file size) now and then. Returns false if cancelled or
+    // the file could not be read; what was indexed so far is kept.
+    bool update(const QString& path, const std::atomic<bool>& cancel,
+                const std::function<void(qint64, qint64)>& progress = {});
+
+    // Complete lines indexed so far
+    qint64 lineCount() const   { return lines_; }
+    qint64 indexedSize() const { return size_; }
+    // Start of the block of kStride lines that `line` falls in
+    qint64 blockStart(qint64 line) const { return (line / kStride) * kStride; }
+    qint64 blockOffset(qint64 line) const { return offsets_[size_t(line / kStride)]; }
+    // Last anchored line stamped at or before `ms`, or 0.
+    qint64 lineBefore(qint64 ms) const;
+    // First anchored line stamped at or after `ms`, or -1.
+    qint64 lineAfter(qint64 ms) const;
+
+private:
+    struct Anchor {
+        qint64 line;
+        qint64 ms;
+    };
+
+    void reset();
+
+    quint64             inode_    = 0;
+    quint64             device_   = 0;
+    quint64             headHash_ = 0;   // of the first kHeadBytes, to spot replaced files
+    qint64              size_     = 0;   // bytes up to the last complete line
+    qint64              lines_    = 0;
+    std::vector<qint64> offsets_;        // start of line i * kStride
+    std::vector<Anchor> anchors_;        // ascending in both line and ms
+};
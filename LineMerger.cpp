@@ -0,0 +1,141 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "LineMerger.h"
+
+#include "Timestamp.h"
+
+#include <QTimer>
+
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace {
+
+// Longest a line is held back waiting for slower sources
+constexpr qint64 kWindowMs = 1000;
+
+}  // namespace
+
+LineMerger::LineMerger(const QStringList& labels, QObject* parent) : QObject(parent) {
+    sources_.resize(size_t(labels.size()));
+    for (qsizetype i = 0; i < labels.size(); ++i)
+        sources_[size_t(i)].label = '[' + labels[i].toUtf8() + "] ";
+}
+
+void LineMerger::start(int maxLines, int flushMs) {
+    maxLines_ = maxLines;
+    flushMs_  = flushMs;
+    clock_.start();
+
+    // Created here so the timer belongs to this (merge) thread
+    timer_ = new QTimer(this);
+    timer_->setSingleShot(true);
+    connect(timer_, &QTimer::timeout, this, &LineMerger::merge);
+}
+
+void LineMerger::push(int source, const LineBatch& lines) {
+    if (counters_) IngestCounters::add(counters_->inFlight, -1);
+    if (lines.noticedNs > 0 && (noticedNs_ == 0 || lines.noticedNs < noticedNs_))
+        noticedNs_ = lines.noticedNs;
+    if (source < 0 || size_t(source) >= sources_.size() || lines.isEmpty()) return;
+    Source& s = sources_[size_t(source)];
+
+    Chunk chunk;
+    chunk.lines   = lines;
+    chunk.arrived = clock_.elapsed();
+    chunk.stamps.reserve(size_t(lines.size()));
+    for (qsizetype i = 0; i < lines.size(); ++i) {
+        const qint64 ts = parseTimestamp(lines.line(i));
+        if (ts >= 0) s.lastTs = qMax(s.lastTs, ts);
+        // Continuation lines (stack traces etc.) stay with their parent line
+        chunk.stamps.push_back(ts >= 0 ? ts : qMax<qint64>(s.lastTs, 0));
+    }
+    s.lastSeen = chunk.arrived;
+    s.queued  += lines.size();
+    s.chunks.push_back(std::move(chunk));
+    trim(s);
+
+    if (!timer_->isActive()) timer_->start(flushMs_);
+}
+
+// No more than maxLines can be shown, so older queued lines are dropped
+void LineMerger::trim(Source& s) {
+    while (s.queued > maxLines_ && !s.chunks.empty()) {
+        Chunk& c = s.chunks.front();
+        const qsizetype drop = qMin(s.queued - maxLines_, c.lines.size() - c.next);
+        c.next   += drop;
+        s.queued -= drop;
+        if (c.next == c.lines.size()) s.chunks.pop_front();
+    }
+}
+
+void LineMerger::merge() {
+    const qint64 now = clock_.elapsed();
+
+    // Safe to release anything no newer than what every active source has
+    // reached; sources quiet for longer than the window do not hold others
+    // up, nor do sources without timestamps, whose lines go out as they come
+    qint64 watermark = std::numeric_limits<qint64>::max();
+    for (const Source& s : sources_)
+        if (s.lastSeen >= 0 && s.lastTs >= 0 && now - s.lastSeen < kWindowMs)
+            watermark = qMin(watermark, s.lastTs);
+
+    using Head = std::pair<qint64, size_t>;   // (timestamp, source); ties keep source order
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap;
+    for (size_t i = 0; i < sources_.size(); ++i) {
+        const Source& s = sources_[i];
+        if (!s.chunks.empty())
+            heap.emplace(s.chunks.front().stamps[size_t(s.chunks.front().next)], i);
+    }
+
+    LineBatch out;
+    QByteArray line;
+    while (!heap.empty()) {
+        const auto [ts, i] = heap.top();
+        Source& s = sources_[i];
+        Chunk&  c = s.chunks.front();
+        if (ts > watermark && now - c.arrived < kWindowMs) break;
+        heap.pop();
+
+        line = s.label;
+        line.append(c.lines.line(c.next));
+        out.append(line, c.lines.severity(c.next));
+        ++c.next;
+        --s.queued;
+        if (c.next == c.lines.size()) s.chunks.pop_front();
+        if (!s.chunks.empty())
+            heap.emplace(s.chunks.front().stamps[size_t(s.chunks.front().next)], i);
+    }
+
+    if (counters_) IngestCounters::add(counters_->overflowed, qMax<qsizetype>(0, out.size() - maxLines_));
+    out.keepLast(maxLines_);
+    if (!out.isEmpty()) {
+        out.noticedNs = noticedNs_;
+        noticedNs_    = 0;
+        if (counters_) IngestCounters::add(counters_->inFlight, 1);
+        emit linesReady(out);
+    }
+
+    // Held-back lines are released by the window at the latest
+    for (const Source& s : sources_) {
+        if (!s.chunks.empty()) {
+            timer_->start(flushMs_);
+            break;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "IngestMetrics.h"
+#include "LineBatch.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+class QTimer;
+
+// Interleaves lines from several files into one stream ordered by parsed
+// timestamp. Each file's FileTailWorker pushes batches here; a heap-based
+// k-way merge releases a line once every active source has caught up to its
+// timestamp, or once it has waited kWindowMs, so one quiet shard can delay
+// the others by at most that long. Lines without a timestamp inherit the
+// previous line's from the same file. Lives on its own thread.
+class LineMerger : public QObject {
+    Q_OBJECT
+
+public:
+    // `labels` are prefixed to each line so shards can be told apart.
+    explicit LineMerger(const QStringList& labels, QObject* parent = nullptr);
+
+    // Batches pushed here and emitted from here are tracked as in flight.
+    void setCounters(std::shared_ptr<IngestCounters> counters) { counters_ = std::move(counters); }
+
+public slots:
+    void start(int maxLines, int flushMs);
+    void push(int source, const LineBatch& lines);
+
+signals:
+    void linesReady(const LineBatch& lines);
+
+private:
+    struct Chunk {
+        LineBatch           lines;
+        std::vector<qint64> stamps;
+        qint64              arrived = 0;
+        qsizetype           next    = 0;
+    };
+    struct Source {
+        QByteArray        label;
+        std::deque<Chunk> chunks;
+        qsizetype         queued   = 0;    // lines not yet released
+        qint64            lastTs   = -1;   // newest timestamp seen
+        qint64            lastSeen = -1;   // arrival of the last batch
+    };
+
+    void merge();
+    void trim(Source& s);
+
+    std::vector<Source> sources_;
+    QElapsedTimer       clock_;
+    QTimer*             timer_    = nullptr;
+    int                 maxLines_ = 500;
+    int                 flushMs_  = 50;
+    qint64              noticedNs_ = 0;   // earliest noticedNs pushed since the last emit
+    std::shared_ptr<IngestCounters> counters_;
+};
@@ -0,0 +1,338 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "LineScanner.h"
+
+#include "JsonLine.h"
+
+#include <QByteArrayView>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <immintrin.h>
+#  define LOGTAIL_X86 1
+#endif
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Emits the line ending at the newline at `nl`, starting at `begin`
+inline void emitLine(const char* data, qsizetype begin, qsizetype nl,
+                     std::vector<LineRecord>& out) {
+    out.push_back(makeRecord(data, begin, nl));
+}
+
+qsizetype scanScalar(const char* data, qsizetype from, qsizetype len, qsizetype begin,
+                     std::vector<LineRecord>& out) {
+    for (qsizetype i = from; i < len; ++i) {
+        if (data[i] == '\n') {
+            emitLine(data, begin, i, out);
+            begin = i + 1;
+        }
+    }
+    return begin;
+}
+
+#ifdef LOGTAIL_X86
+
+constexpr qsizetype kShortestKeyword = [] {
+    qsizetype n = kSeverityHeadBytes;
+    for (const SeverityKeyword& kw : kSeverityKeywords) n = std::min(n, qsizetype(kw.word.size()));
+    return n;
+}();
+// Bytes past a line's start the vector keyword match may load: the last
+// window ends 32 bytes past start 8 (AVX2) or 16 past start 24 (SSE2),
+// plus one for the second-letter load
+constexpr qsizetype kHeadReach = kSeverityHeadBytes + 1;
+
+// The vector keyword match works in two steps. The kernels compare every
+// start position of the head at once against each keyword's first two
+// letters, with bit 5 cleared (which upper-cases letters and turns nothing
+// else into one); confirmKeywords() then checks only the positions that
+// passed. Lines without a keyword, and most lines with one, settle in the
+// vector step plus a compare or two.
+
+// Starts within a head of `n` bytes from which a keyword of `len` fits
+inline quint64 fittingStarts(qsizetype n, qsizetype len) {
+    return (quint64(2) << (n - len)) - 1;
+}
+
+// Keywords come most severe first, so the lowest index matching at any of
+// the `candidates` decides, as in classifyKeywords()
+Severity confirmKeywords(const char* head, qsizetype n, quint64 candidates) {
+    constexpr qsizetype kCount = qsizetype(std::size(kSeverityKeywords));
+    qsizetype best = kCount;
+    while (candidates) {
+        const qsizetype i = __builtin_ctzll(candidates);
+        candidates &= candidates - 1;
+        for (qsizetype k = 0; k < best; ++k) {
+            const std::string_view word = kSeverityKeywords[k].word;
+            const qsizetype        len  = qsizetype(word.size());
+            if (i + len > n) continue;
+            qsizetype j = 0;
+            while (j < len && (head[i + j] & 0xdf) == word[size_t(j)]) ++j;
+            if (j == len) {
+                best = k;
+                break;
+            }
+        }
+        if (best < kCount && kSeverityKeywords[best].severity == Severity::Error) break;
+    }
+    return best < kCount ? kSeverityKeywords[best].severity : Severity::Plain;
+}
+
+__attribute__((target("sse2")))
+Severity keywordsSse2(const char* head, qsizetype n) {
+    if (n < kShortestKeyword) return Severity::Plain;
+    // Windows at offsets 0, 16 and 24 cover starts 0..39
+    constexpr int kWindows[] = {0, 16, 24};
+    const __m128i fold       = _mm_set1_epi8(char(0xdf));
+    quint64       candidates = 0;
+    for (const int w : kWindows) {
+        const char*   p      = head + w;
+        const __m128i first  = _mm_and_si128(fold, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        const __m128i second = _mm_and_si128(fold, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1)));
+        __m128i any = _mm_setzero_si128();
+        for (const SeverityKeyword& kw : kSeverityKeywords)
+            any = _mm_or_si128(any, _mm_and_si128(_mm_cmpeq_epi8(first,  _mm_set1_epi8(kw.word[0])),
+                                                  _mm_cmpeq_epi8(second, _mm_set1_epi8(kw.word[1]))));
+        candidates |= quint64(unsigned(_mm_movemask_epi8(any))) << w;
+    }
+    candidates &= fittingStarts(n, kShortestKeyword);
+    return candidates ? confirmKeywords(head, n, candidates) : Severity::Plain;
+}
+
+__attribute__((target("avx2")))
+Severity keywordsAvx2(const char* head, qsizetype n) {
+    if (n < kShortestKeyword) return Severity::Plain;
+    // Windows at offsets 0 and 8 cover starts 0..39
+    constexpr int kWindows[] = {0, 8};
+    const __m256i fold       = _mm256_set1_epi8(char(0xdf));
+    quint64       candidates = 0;
+    for (const int w : kWindows) {
+        const char*   p      = head + w;
+        const __m256i first  = _mm256_and_si256(fold, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+        const __m256i second = _mm256_and_si256(fold, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1)));
+        __m256i any = _mm256_setzero_si256();
+        for (const SeverityKeyword& kw : kSeverityKeywords)
+            any = _mm256_or_si256(any, _mm256_and_si256(_mm256_cmpeq_epi8(first,  _mm256_set1_epi8(kw.word[0])),
+                                                        _mm256_cmpeq_epi8(second, _mm256_set1_epi8(kw.word[1]))));
+        candidates |= quint64(unsigned(_mm256_movemask_epi8(any))) << w;
+    }
+    candidates &= fittingStarts(n, kShortestKeyword);
+    return candidates ? confirmKeywords(head, n, candidates) : Severity::Plain;
+}
+
+// makeRecord() with the keyword match done by `keywords` while the line is
+// still in cache. Heads too close to the end of the buffer for the vector
+// loads, and JSON lines, take the scalar path.
+template <Severity (*keywords)(const char*, qsizetype)>
+inline void emitLineVector(const char* data, qsizetype len, qsizetype begin, qsizetype nl,
+                           std::vector<LineRecord>& out) {
+    qsizetype end = nl;
+    while (begin < end && isSpace(data[begin]))   ++begin;
+    while (end > begin && isSpace(data[end - 1])) --end;
+    const QByteArrayView line(data + begin, end - begin);
+    const Severity severity =
+          line.isEmpty() ? Severity::Plain
+        : begin + kHeadReach > len || JsonScanner::looksLikeObject(line) ? classifyLine(line)
+        : keywords(line.data(), qMin(line.size(), kSeverityHeadBytes));
+    out.push_back({quint32(begin), quint32(end - begin), severity});
+}
+
+// Each kernel compares a block of bytes against '\n', then walks the set bits
+// of the resulting mask; lines are classified as their newline is found.
+// SSE2 is baseline only on x86-64, so 32-bit builds need the attribute too.
+__attribute__((target("sse2")))
+qsizetype scanSse2(const char* data, qsizetype len, std::vector<LineRecord>& out) {
+    const __m128i nl    = _mm_set1_epi8('\n');
+    qsizetype     begin = 0;
+    qsizetype     i     = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(block, nl)));
+        while (mask) {
+            const qsizetype pos = i + __builtin_ctz(mask);
+            emitLineVector<keywordsSse2>(data, len, begin, pos, out);
+            begin = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    return scanScalar(data, i, len, begin, out);
+}
+
+__attribute__((target("avx2")))
+qsizetype scanAvx2(const char* data, qsizetype len, std::vector<LineRecord>& out) {
+    const __m256i nl    = _mm256_set1_epi8('\n');
+    qsizetype     begin = 0;
+    qsizetype     i     = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned mask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, nl)));
+        while (mask) {
+            const qsizetype pos = i + __builtin_ctz(mask);
+            emitLineVector<keywordsAvx2>(data, len, begin, pos, out);
+            begin = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    return scanScalar(data, i, len, begin, out);
+}
+
+#endif
+
+using ScanFn = qsizetype (*)(const char*, qsizetype, std::vector<LineRecord>&);
+
+ScanFn pickKernel() {
+#ifdef LOGTAIL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return scanAvx2;
+    if (__builtin_cpu_supports("sse2")) return scanSse2;
+#endif
+    return [](const char* data, qsizetype len, std::vector<LineRecord>& out) {
+        return scanScalar(data, 0, len, 0, out);
+    };
+}
+
+// True when none of the eight bytes needs a closer look: no high bit, no
+// byte below 0x20 and no DEL. Tabs fail too, but only their word is rechecked
+inline bool wordIsPlain(quint64 w) {
+    constexpr quint64 kOnes = 0x0101010101010101ull;
+    constexpr quint64 kHigh = 0x8080808080808080ull;
+    const quint64 del = w ^ (0x7f * kOnes);
+    return ((w | ((w - 0x20 * kOnes) & ~w) | ((del - kOnes) & ~del)) & kHigh) == 0;
+}
+
+// Length of the valid UTF-8 sequence at p, or 0 for an invalid byte.
+// Rejects overlong forms, surrogates and code points past U+10FFFF.
+qsizetype utf8Length(const uchar* p, qsizetype n) {
+    const uchar c = p[0];
+    qsizetype   len;
+    uchar       lo = 0x80, hi = 0xbf;   // bounds for the second byte
+    if      (c < 0x80)  return 1;
+    else if (c < 0xc2)  return 0;
+    else if (c < 0xe0)  len = 2;
+    else if (c < 0xf0) {
+        len = 3;
+        if (c == 0xe0) lo = 0xa0;
+        if (c == 0xed) hi = 0x9f;
+    } else if (c < 0xf5) {
+        len = 4;
+        if (c == 0xf0) lo = 0x90;
+        if (c == 0xf4) hi = 0x8f;
+    } else {
+        return 0;
+    }
+    if (n < len || p[1] < lo || p[1] > hi) return 0;
+    for (qsizetype i = 2; i < len; ++i)
+        if ((p[i] & 0xc0) != 0x80) return 0;
+    return len;
+}
+
+bool isAllowedControl(uchar c) {
+    return c == '\t' || c == 0x1b;
+}
+
+}  // namespace
+
+LineRecord makeRecord(const char* data, qsizetype begin, qsizetype end) {
+    while (begin < end && isSpace(data[begin]))   ++begin;
+    while (end > begin && isSpace(data[end - 1])) --end;
+    const QByteArrayView line(data + begin, end - begin);
+    return {quint32(begin), quint32(end - begin),
+            line.isEmpty() ? Severity::Plain : classifyLine(line)};
+}
+
+qint64 scanBack(const char* data, qint64 len, int lines, BackScan& st) {
+    for (qint64 i = len - 1; i >= 0; --i) {
+        const char c = data[i];
+        if (c == '\n') {
+            if (st.terminated && st.content && ++st.found == lines) return i + 1;
+            st.terminated = true;
+            st.content    = false;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            st.content = true;
+        }
+    }
+    return -1;
+}
+
+qsizetype scanLines(const char* data, qsizetype len, std::vector<LineRecord>& out) {
+    static const ScanFn kernel = pickKernel();
+    return kernel(data, len, out);
+}
+
+QByteArrayView sanitizeLine(QByteArrayView line, QByteArray& scratch, qint64 cutBefore) {
+    const auto*     p = reinterpret_cast<const uchar*>(line.data());
+    const qsizetype n = line.size();
+
+    // Fast path: nearly every line is short printable ASCII or valid UTF-8
+    qsizetype i = 0;
+    if (cutBefore == 0 && n <= kMaxLineBytes) {
+        while (i < n) {
+            if (i + 8 <= n) {
+                quint64 w;
+                std::memcpy(&w, p + i, 8);
+                if (wordIsPlain(w)) {
+                    i += 8;
+                    continue;
+                }
+            }
+            const uchar c = p[i];
+            if (c >= 0x20 && c < 0x7f) {
+                ++i;
+            } else if (c >= 0x80) {
+                const qsizetype len = utf8Length(p + i, n - i);
+                if (len == 0) break;
+                i += len;
+            } else if (isAllowedControl(c)) {
+                ++i;
+            } else {
+                break;
+            }
+        }
+        if (i == n) return line;
+    }
+
+    // Slow path: copy what was checked, then escape as we go
+    static constexpr char kHex[] = "0123456789abcdef";
+    scratch.clear();
+    scratch.reserve(qMin(n, kMaxLineBytes) + 32);
+    scratch.append(line.data(), i);
+    while (i < n && scratch.size() < kMaxLineBytes) {
+        const uchar     c   = p[i];
+        const qsizetype len = c >= 0x80 ? utf8Length(p + i, n - i)
+                            : (c >= 0x20 && c < 0x7f) || isAllowedControl(c) ? 1 : 0;
+        if (len > 0) {
+            if (scratch.size() + len > kMaxLineBytes) break;
+            scratch.append(line.data() + i, len);
+            i += len;
+        } else {
+            const char escaped[] = {'\\', 'x', kHex[c >> 4], kHex[c & 0xf]};
+            scratch.append(escaped, 4);
+            ++i;
+        }
+    }
+    if (const qint64 cut = cutBefore + (n - i); cut > 0)
+        scratch.append(" … [").append(QByteArray::number(cut)).append(" bytes cut]");
+    return scratch;
+}
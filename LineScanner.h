@@ -0,0 +1,66 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Severity.h"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QtGlobal>
+
+#include <vector>
+
+// One line found by scanLines(), relative to the scanned buffer. Surrounding
+// whitespace is already trimmed off; a blank line has length 0.
+struct LineRecord {
+    quint32  offset;
+    quint32  length;
+    Severity severity;
+};
+
+// Finds every '\n' in [data, data + len) and, in the same pass, classifies
+// each complete line from its first bytes. Records are appended to `out`.
+// Returns the offset just past the last newline; anything after it is an
+// unterminated partial line. Uses AVX2 or SSE2 when the CPU has them.
+qsizetype scanLines(const char* data, qsizetype len, std::vector<LineRecord>& out);
+
+// Builds the record for one line given without its terminator.
+LineRecord makeRecord(const char* data, qsizetype begin, qsizetype end);
+
+// State of a right-to-left line count carried across chunks, see scanBack().
+struct BackScan {
+    int  found      = 0;
+    bool terminated = false;   // passed the newline ending the last complete line
+    bool content    = false;   // non-blank bytes since the newline to the right
+};
+
+// Scans data right to left, counting non-blank complete lines; returns the
+// index where the `lines`-th one counted so far begins, or -1 if it needs
+// more data to the left.
+qint64 scanBack(const char* data, qint64 len, int lines, BackScan& st);
+
+// Longest line kept, in bytes. Readers stop buffering an unterminated line
+// past this, so a file without newlines cannot grow memory without bound.
+constexpr qsizetype kMaxLineBytes = 64 * 1024;
+
+// Returns `line` itself when it is valid UTF-8 of at most kMaxLineBytes
+// with no control characters but tab and ESC, which is checked eight bytes
+// at a time. Otherwise builds a copy in `scratch`: invalid bytes and
+// control characters become \xNN, and the text is cut at a character
+// boundary with a note of how many bytes were cut, counting `cutBefore`
+// bytes the reader already dropped.
+QByteArrayView sanitizeLine(QByteArrayView line, QByteArray& scratch, qint64 cutBefore = 0);
@@ -0,0 +1,183 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "LineStore.h"
+
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Lines longer than this get a page of their own
+constexpr qsizetype kPageSize  = 256 * 1024;
+// Drained pages kept around instead of being freed
+constexpr size_t    kMaxSpares = 2;
+
+}  // namespace
+
+LineStore::LineStore(qsizetype capacity) : capacity_(qMax<qsizetype>(1, capacity)) {}
+
+void LineStore::setCapacity(qsizetype capacity) {
+    capacity = qMax<qsizetype>(1, capacity);
+    if (capacity == capacity_) return;
+
+    QWriteLocker locker(&lock_);
+
+    // Unroll the ring so row 0 sits in slot 0, dropping the oldest rows if shrinking
+    const qsizetype drop = qMax<qsizetype>(0, size() - capacity);
+    std::vector<Ref> refs;
+    refs.reserve(size_t(size() - drop));
+    for (qsizetype row = 0; row < size(); ++row) {
+        if (row < drop) release(ref(row));
+        else            refs.push_back(ref(row));
+    }
+    refs_      = std::move(refs);
+    head_      = 0;
+    capacity_  = capacity;
+    evicted_  += drop;
+}
+
+void LineStore::setDedup(Dedup mode) {
+    QWriteLocker locker(&lock_);
+    dedup_ = mode;
+    recent_.fill({});
+}
+
+void LineStore::clear() {
+    QWriteLocker locker(&lock_);
+    recent_.fill({});   // stable ids start over
+    refs_.clear();
+    refs_.shrink_to_fit();
+    pages_.clear();
+    spare_.clear();
+    head_      = 0;
+    evicted_   = 0;
+    firstPage_ = 0;
+}
+
+bool LineStore::append(QByteArrayView line, Severity severity) {
+    QWriteLocker locker(&lock_);
+    return appendLocked(line, severity);
+}
+
+void LineStore::append(const LineBatch& lines) {
+    QWriteLocker locker(&lock_);
+    for (qsizetype i = 0; i < lines.size(); ++i)
+        appendLocked(lines.line(i), lines.severity(i));
+}
+
+bool LineStore::appendLocked(QByteArrayView line, Severity severity) {
+    quint64 key = 0;
+    if (dedup_ != Dedup::Off) {
+        key = dedupKey(line);
+        if (foldRepeat(key, line, severity)) return false;
+    }
+
+    const bool full = size() == capacity_;
+    if (full) release(refs_[head_]);
+
+    Page& page = pageFor(line.size());
+    std::memcpy(page.data.get() + page.used, line.data(), size_t(line.size()));
+    const Ref ref{firstPage_ + qint64(pages_.size()) - 1,
+                  quint32(page.used), quint32(line.size()), severity};
+    page.used += line.size();
+    ++page.lines;
+
+    if (full) {
+        refs_[head_] = ref;
+        head_ = (head_ + 1) % capacity_;
+        ++evicted_;
+    } else {
+        refs_.push_back(ref);
+    }
+    if (dedup_ != Dedup::Off) {
+        recent_[size_t(recentNext_)] = {key, evicted_ + size() - 1};
+        recentNext_ = (recentNext_ + 1) % kDedupWindow;
+    }
+    return full;
+}
+
+// FNV-1a; IgnoreNumbers hashes each run of digits as a single '0', so lines
+// differing only in timestamps, ids or counts get the same key
+quint64 LineStore::dedupKey(QByteArrayView line) const {
+    quint64 h = 0xcbf29ce484222325ull;
+    bool    inDigits = false;
+    for (const char c : line) {
+        const bool digit = c >= '0' && c <= '9';
+        if (dedup_ == Dedup::IgnoreNumbers && digit) {
+            if (inDigits) continue;
+            inDigits = true;
+            h = (h ^ quint8('0')) * 0x100000001b3ull;
+            continue;
+        }
+        inDigits = false;
+        h = (h ^ quint8(c)) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+bool LineStore::foldRepeat(quint64 key, QByteArrayView line, Severity severity) {
+    for (const Recent& recent : recent_) {
+        if (recent.id < evicted_ || recent.key != key) continue;
+        const qsizetype row = qsizetype(recent.id - evicted_);
+        if (row >= size()) continue;
+        Ref& r = refs_[(head_ + row) % refs_.size()];
+        if (r.severity != severity) continue;
+        // A key match is enough when digits are ignored anyway
+        if (dedup_ == Dedup::Exact && this->line(row) != line) continue;
+        if (r.repeats < std::numeric_limits<quint32>::max()) ++r.repeats;
+        return true;
+    }
+    return false;
+}
+
+QByteArrayView LineStore::line(qsizetype row) const {
+    const Ref&  r = ref(row);
+    const Page& p = pages_[size_t(r.page - firstPage_)];
+    return QByteArrayView(p.data.get() + r.offset, r.length);
+}
+
+LineStore::Page& LineStore::pageFor(qsizetype len) {
+    if (!pages_.empty() && pages_.back().size - pages_.back().used >= len)
+        return pages_.back();
+
+    if (len <= kPageSize && !spare_.empty()) {
+        pages_.push_back(std::move(spare_.back()));
+        spare_.pop_back();
+    } else {
+        Page page;
+        page.size = qMax(kPageSize, len);
+        page.data = std::make_unique_for_overwrite<char[]>(size_t(page.size));
+        pages_.push_back(std::move(page));
+    }
+    return pages_.back();
+}
+
+void LineStore::release(const Ref& ref) {
+    --pages_[size_t(ref.page - firstPage_)].lines;
+
+    // Lines are evicted oldest first, so pages drain from the front. The
+    // newest page stays even when empty since it is still being filled.
+    while (pages_.size() > 1 && pages_.front().lines == 0) {
+        Page page = std::move(pages_.front());
+        pages_.pop_front();
+        ++firstPage_;
+        if (page.size == kPageSize && spare_.size() < kMaxSpares) {
+            page.used = 0;
+            spare_.push_back(std::move(page));
+        }
+    }
+}
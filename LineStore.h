@@ -0,0 +1,110 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "LineBatch.h"
+#include "Severity.h"
+
+#include <QByteArrayView>
+#include <QReadWriteLock>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Fixed-capacity ring of log lines stored as raw UTF-8 in large reusable
+// pages. Each line is an (page, offset, length) view plus a severity byte, so
+// appending costs one memcpy and eviction never touches the allocator until
+// a whole page drains, at which point it is kept for reuse.
+//
+// The store belongs to one thread, which mutates it and reads it freely.
+// Mutators take lock() for writing so that other threads can read under
+// lock() without racing them; rows may be evicted between two such reads.
+//
+// With dedup on, a line that repeats one of the last kDedupWindow stored
+// lines (same severity, same text or same text but for digits) is not
+// stored; the earlier row's repeat count goes up instead.
+class LineStore {
+public:
+    enum class Dedup { Off, Exact, IgnoreNumbers };
+    static constexpr int kDedupWindow = 8;
+
+    explicit LineStore(qsizetype capacity = 500);
+
+    void setDedup(Dedup mode);
+
+    // Keeps the newest lines that still fit.
+    void setCapacity(qsizetype capacity);
+    void clear();
+
+    // Returns true if the oldest line was evicted to make room.
+    bool append(QByteArrayView line, Severity severity);
+    void append(const LineBatch& lines);
+
+    qsizetype      size() const     { return qsizetype(refs_.size()); }
+    qsizetype      capacity() const { return capacity_; }
+    // Total lines evicted so far; row + evicted() is stable across appends.
+    qint64         evicted() const  { return evicted_; }
+
+    // Row 0 is the oldest retained line.
+    QByteArrayView line(qsizetype row) const;
+    Severity       severity(qsizetype row) const { return ref(row).severity; }
+    // How many times the row's line arrived; 1 unless repeats were folded in.
+    quint32        repeats(qsizetype row) const  { return ref(row).repeats; }
+
+    QReadWriteLock& lock() const { return lock_; }
+
+private:
+    struct Page {
+        std::unique_ptr<char[]> data;
+        qsizetype               size  = 0;
+        qsizetype               used  = 0;
+        qsizetype               lines = 0;   // live lines stored in this page
+    };
+    struct Ref {
+        qint64   page;       // page sequence number, see firstPage_
+        quint32  offset;
+        quint32  length;
+        Severity severity;
+        quint32  repeats = 1;
+    };
+    struct Recent {
+        quint64 key = 0;
+        qint64  id  = -1;   // stable id of the row
+    };
+
+    const Ref& ref(qsizetype row) const { return refs_[(head_ + row) % refs_.size()]; }
+    bool       appendLocked(QByteArrayView line, Severity severity);
+    quint64    dedupKey(QByteArrayView line) const;
+    // Bumps a recent row this line repeats; false if there is none.
+    bool       foldRepeat(quint64 key, QByteArrayView line, Severity severity);
+    Page&      pageFor(qsizetype len);
+    void       release(const Ref& ref);
+
+    std::vector<Ref>  refs_;
+    qsizetype         head_      = 0;   // slot of row 0 once the ring is full
+    qsizetype         capacity_  = 500;
+    qint64            evicted_   = 0;
+    std::deque<Page>  pages_;
+    qint64            firstPage_ = 0;   // sequence number of pages_.front()
+    std::vector<Page> spare_;           // drained pages kept for reuse
+    Dedup             dedup_     = Dedup::Off;
+    std::array<Recent, kDedupWindow> recent_ {};   // newest rows, as a ring
+    qsizetype         recentNext_ = 0;
+    mutable QReadWriteLock lock_;
+};
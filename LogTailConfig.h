@@ -0,0 +1,44 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "IngestQueue.h"
+#include "LineFilter.h"
+#include "LineStore.h"
+
+#include <QString>
+#include <QStringList>
+
+struct LogTailConfig {
+    enum class Source { None, File, Journalctl, Remote };
+    Source  source      = Source::None;
+    QString filePath;
+    QString journalUnit;   // empty = no -u filter
+    QString remoteHost;    // ssh destination, e.g. user@host
+    QString remotePath;
+    QString remoteAgent = "logtail-agent";   // command that starts the agent there
+    int     maxLines    = 500;
+    int     flushMs     = 50;      // batch window for new lines, in ms
+    LineFilter::Spec filter;       // per widget, applied by the view
+    bool    filterAtSource = false;   // also drop rejected lines before they are stored
+    bool    stitchRotated  = false;   // seed a short file from <path>.1, .2.gz, ...
+    // What gives when lines arrive faster than one buffer's worth per flush
+    IngestQueue::Policy overload = IngestQueue::Policy::DropOldest;
+    LineStore::Dedup    dedup    = LineStore::Dedup::Off;   // fold repeated lines into ×N
+    bool    jsonColumns    = false;   // per widget: show JSON lines as columns
+    QStringList jsonKeys;             // extra keys shown after the message
+};
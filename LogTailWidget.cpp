@@ -15,63 +15,90 @@
 
 #include "LogTailWidget.h"
 
+#include "FileTailWorker.h"
+#include "IngestMetrics.h"
+#include "LogTailConfig.h"
+#include "LogView.h"
+#include "ScrollbackView.h"
+#include "SeverityGraph.h"
+#include "TailSource.h"
+#include "Timestamp.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDateTime>
 #include <QDialogButtonBox>
 #include <QFileDialog>
 #include <QFileInfo>
-#include <QFileSystemWatcher>
 #include <QGridLayout>
+#include <QGuiApplication>
+#include <QPointer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
-#include <QPlainTextEdit>
-#include <QProcess>
 #include <QPushButton>
 #include <QRadioButton>
-#include <QScrollBar>
+#include <QRegularExpression>
+#include <QShortcut>
 #include <QSpinBox>
+#include <QSignalBlocker>
 #include <QStackedWidget>
-#include <QTextCharFormat>
-#include <QTextCursor>
+#include <QTimer>
+#include <QToolButton>
 #include <QVBoxLayout>
 
 #include <QDialog>
-#include <QFile>
 #include <QFileInfo>
 
-// ── Config struct ─────────────────────────────────────────────────────────────
+#include <functional>
+#include <memory>
 
-struct LogTailConfig {
-    enum class Source { None, File, Journalctl };
-    Source  source      = Source::None;
-    QString filePath;
-    QString journalUnit;   // empty = no -u filter
-    int     maxLines    = 500;
+// ── LogTailDisplay ────────────────────────────────────────────────────────────
+
+namespace {
+
+const QString kUnconfigured = QStringLiteral("No log source configured.\nClick \u2699 to set up.");
+
+const QString kFilterStyle = QStringLiteral(
+    "QLineEdit { background: #0d1117; color: #c8cee8; border: 1px solid #2d3748;"
+    "  border-radius: 3px; font-family: monospace; font-size: 10px; padding: 0 4px; }");
+
+// Sources restored with a dashboard start one per event-loop pass, so the
+// dashboard is built and painted before any widget opens a file or spawns a
+// process, and its first frames are not held up by all of them at once.
+// Only widgets on screen are queued; the rest wait until they are shown.
+struct Activation {
+    QPointer<QObject>     owner;
+    std::function<void()> activate;
 };
 
-// ── Helpers ───────────────────────────────────────────────────────────────────
+QList<Activation>& activationQueue() {
+    static QList<Activation> queue;
+    return queue;
+}
 
-namespace {
+void activateNext() {
+    QList<Activation>& queue = activationQueue();
+    while (!queue.isEmpty()) {
+        const Activation next = queue.takeFirst();
+        if (!next.owner) continue;   // closed before its turn
+        next.activate();
+        break;
+    }
+    if (!queue.isEmpty()) QTimer::singleShot(0, qApp, activateNext);
+}
 
-QColor colorForLine(const QString& line) {
-    // Check the first ~40 chars; avoids scanning megabyte-long lines
-    const QString head = line.left(40).toUpper();
-    if (head.contains("ERROR")  || head.contains("FATAL") ||
-        head.contains("CRIT")   || head.contains("EMERG") ||
-        head.contains("ALERT"))
-        return QColor("#ff5555");
-    if (head.contains("WARN"))
-        return QColor("#ffb86c");
-    if (head.contains("DEBUG") || head.contains("TRACE") || head.contains("VERBOSE"))
-        return QColor("#6272a4");
-    if (head.contains("INFO")  || head.contains("NOTICE"))
-        return QColor("#8be9fd");
-    return QColor("#c8cee8");
+void queueActivation(QObject* owner, std::function<void()> activate) {
+    QList<Activation>& queue = activationQueue();
+    queue.append({owner, std::move(activate)});
+    if (queue.size() == 1) QTimer::singleShot(0, qApp, activateNext);
 }
 
 }  // namespace
 
-// ── LogTailDisplay ────────────────────────────────────────────────────────────
-
 class LogTailDisplay : public QWidget {
     Q_OBJECT
 
@@ -87,11 +114,27 @@ public:
         switch (config_.source) {
             case LogTailConfig::Source::File:        obj["sourceType"] = "file";        break;
             case LogTailConfig::Source::Journalctl:  obj["sourceType"] = "journalctl"; break;
+            case LogTailConfig::Source::Remote:      obj["sourceType"] = "remote";      break;
             default:                                 obj["sourceType"] = "";            break;
         }
         obj["filePath"]    = config_.filePath;
         obj["journalUnit"] = config_.journalUnit;
+        obj["remoteHost"]  = config_.remoteHost;
+        obj["remotePath"]  = config_.remotePath;
+        obj["remoteAgent"] = config_.remoteAgent;
         obj["maxLines"]    = config_.maxLines;
+        obj["flushMs"]     = config_.flushMs;
+        obj["filterText"]    = config_.filter.pattern;
+        obj["filterRegex"]   = config_.filter.regex;
+        obj["filterExclude"] = config_.filter.exclude;
+        obj["minSeverity"]   = config_.filter.minLevel;
+        obj["filterAtSource"] = config_.filterAtSource;
+        obj["stitchRotated"]  = config_.stitchRotated;
+        obj["overload"]       = int(config_.overload);
+        obj["dedup"]          = int(config_.dedup);
+        obj["jsonColumns"]    = config_.jsonColumns;
+        obj["jsonKeys"]       = QJsonArray::fromStringList(config_.jsonKeys);
+        obj["showMetrics"]    = showMetrics_;
         return obj;
     }
 
@@ -99,13 +142,50 @@ public:
         const QString type = obj["sourceType"].toString();
         if      (type == "file")        config_.source = LogTailConfig::Source::File;
         else if (type == "journalctl")  config_.source = LogTailConfig::Source::Journalctl;
+        else if (type == "remote")      config_.source = LogTailConfig::Source::Remote;
         else                            config_.source = LogTailConfig::Source::None;
 
         config_.filePath    = obj["filePath"].toString();
         config_.journalUnit = obj["journalUnit"].toString();
+        config_.remoteHost  = obj["remoteHost"].toString();
+        config_.remotePath  = obj["remotePath"].toString();
+        config_.remoteAgent = obj.value("remoteAgent").toString("logtail-agent");
         config_.maxLines    = obj.value("maxLines").toInt(500);
+        config_.flushMs     = obj.value("flushMs").toInt(50);
+        config_.filterAtSource = obj["filterAtSource"].toBool();
+        config_.stitchRotated  = obj["stitchRotated"].toBool();
+        config_.overload       = IngestQueue::Policy(qBound(0, obj["overload"].toInt(), 2));
+        config_.dedup          = LineStore::Dedup(qBound(0, obj["dedup"].toInt(), 2));
+        config_.jsonKeys.clear();
+        for (const QJsonValue& key : obj["jsonKeys"].toArray())
+            config_.jsonKeys.append(key.toString());
+        showMetrics_ = obj["showMetrics"].toBool();
+        metricsLabel_->setVisible(showMetrics_);
+
+        {
+            const QSignalBlocker b1(filterEdit_), b2(regexBtn_), b3(excludeBtn_), b4(levelBox_);
+            filterEdit_->setText(obj["filterText"].toString());
+            regexBtn_->setChecked(obj["filterRegex"].toBool());
+            excludeBtn_->setChecked(obj["filterExclude"].toBool());
+            levelBox_->setCurrentIndex(qBound(0, obj["minSeverity"].toInt(), levelBox_->count() - 1));
+        }
+        {
+            const QSignalBlocker b(jsonBtn_);
+            jsonBtn_->setChecked(obj["jsonColumns"].toBool());
+        }
+        applyProjection();
+        applyFilter();
+        deferSource();
+    }
 
-        applySource();
+signals:
+    // Once a second while a source is running; see IngestMetrics::toJson().
+    void metricsUpdated(const QJsonObject& metrics);
+
+protected:
+    void showEvent(QShowEvent* event) override {
+        QWidget::showEvent(event);
+        if (deferred_) queueSource();
     }
 
 private:
@@ -113,7 +193,7 @@ private:
     void setupUi() {
         setStyleSheet(
             "QWidget { background: transparent; }"
-            "QPlainTextEdit {"
+            "LogView {"
             "  background: #0d1117; color: #c8cee8;"
             "  border: none; font-family: monospace; font-size: 11px; }"
             "QScrollBar:vertical { background: #0d1117; width: 6px; border: none; }"
@@ -145,10 +225,120 @@ private:
             "  color: #5588cc; font-size: 14px; padding: 0; }"
             "QPushButton:hover { color: #88bbff; }");
 
+        // Filter bar: substring or regex, include or exclude, severity threshold
+        filterEdit_ = new QLineEdit(header);
+        filterEdit_->setPlaceholderText("filter");
+        filterEdit_->setClearButtonEnabled(true);
+        filterEdit_->setFixedWidth(140);
+        filterEdit_->setToolTip("Show lines containing this text.\n"
+                                "Case-insensitive unless the filter has upper-case letters.");
+        filterEdit_->setStyleSheet(kFilterStyle);
+
+        const auto makeToggle = [header](const QString& text, const QString& tip) {
+            auto* btn = new QToolButton(header);
+            btn->setText(text);
+            btn->setToolTip(tip);
+            btn->setCheckable(true);
+            btn->setFixedSize(20, 20);
+            btn->setStyleSheet(
+                "QToolButton { background: transparent; border: none;"
+                "  color: #506080; font-family: monospace; font-size: 10px; }"
+                "QToolButton:checked { color: #88bbff; background: #1f2a3a; border-radius: 3px; }");
+            return btn;
+        };
+        regexBtn_   = makeToggle(".*", "Regular expression");
+        excludeBtn_ = makeToggle("!",  "Hide matching lines instead");
+
+        levelBox_ = new QComboBox(header);
+        levelBox_->addItems({"all", "info+", "warn+", "error"});   // severityLevel() thresholds
+        levelBox_->setToolTip("Minimum severity");
+        levelBox_->setStyleSheet(
+            "QComboBox { background: #0d1117; color: #8899bb; border: 1px solid #2d3748;"
+            "  font-size: 10px; padding: 0 4px; }");
+
+        // How a file source learns of new data: inotify, or polling on
+        // network filesystems where inotify misses other hosts' writes
+        watchLabel_ = new QLabel(header);
+        watchLabel_->setStyleSheet(
+            "color: #506080; font-size: 9px; font-family: monospace;"
+            "background: transparent; border: none;");
+        watchLabel_->setVisible(false);
+
+        // Line rate by severity over the last minute
+        severityGraph_ = new SeverityGraph(header);
+
+        // Optional ingestion metrics overlay, refreshed once a second
+        metricsLabel_ = new QLabel(header);
+        metricsLabel_->setStyleSheet(
+            "color: #506080; font-size: 9px; font-family: monospace;"
+            "background: transparent; border: none;");
+        metricsLabel_->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Preferred);
+        metricsLabel_->setVisible(false);
+
+        // Lines shed under overload; shown once there are any
+        dropLabel_ = new QLabel(header);
+        dropLabel_->setStyleSheet(
+            "color: #ffb86c; font-size: 9px; font-family: monospace;"
+            "background: transparent; border: none;");
+        dropLabel_->setVisible(false);
+
         headerLayout->addWidget(sourceLabel_, 1);
+        headerLayout->addWidget(watchLabel_);
+        headerLayout->addWidget(severityGraph_);
+        headerLayout->addWidget(metricsLabel_, 2);
+        headerLayout->addWidget(dropLabel_);
+        headerLayout->addWidget(filterEdit_);
+        headerLayout->addWidget(regexBtn_);
+        headerLayout->addWidget(excludeBtn_);
+        historyBtn_ = makeToggle("⇞", "Scroll back through the whole file");
+        jsonBtn_    = makeToggle("{}", "Show JSON lines as time, level, message and the\n"
+                                       "keys picked in the settings");
+
+        headerLayout->addWidget(levelBox_);
+        headerLayout->addWidget(jsonBtn_);
+        headerLayout->addWidget(historyBtn_);
         headerLayout->addWidget(configBtn_);
         vbox->addWidget(header);
 
+        // ── Search bar (Ctrl+F) ───────────────────────────────────────────────
+        searchBar_ = new QWidget(this);
+        searchBar_->setStyleSheet("background: #161b22; border-bottom: 1px solid #2d3748;");
+        searchBar_->setFixedHeight(26);
+        auto* searchLayout = new QHBoxLayout(searchBar_);
+        searchLayout->setContentsMargins(8, 0, 4, 0);
+        searchLayout->setSpacing(4);
+        searchEdit_ = new QLineEdit(searchBar_);
+        searchEdit_->setPlaceholderText("find");
+        searchEdit_->setClearButtonEnabled(true);
+        searchEdit_->setToolTip("Highlight lines containing this text among those shown.\n"
+                                "Enter: next, Shift+Enter: previous, Esc: close.");
+        searchEdit_->setStyleSheet(kFilterStyle);
+        searchRegexBtn_ = makeToggle(".*", "Regular expression");
+        const auto makeStep = [this](const QString& text, const QString& tip) {
+            auto* btn = new QToolButton(searchBar_);
+            btn->setText(text);
+            btn->setToolTip(tip);
+            btn->setFixedSize(20, 20);
+            btn->setStyleSheet(
+                "QToolButton { background: transparent; border: none;"
+                "  color: #8899bb; font-size: 10px; }"
+                "QToolButton:hover { color: #88bbff; }");
+            return btn;
+        };
+        auto* prevBtn = makeStep("▲", "Previous match (Shift+Enter)");
+        auto* nextBtn = makeStep("▼", "Next match (Enter)");
+        searchCount_ = new QLabel(searchBar_);
+        searchCount_->setStyleSheet(
+            "color: #506080; font-size: 10px; font-family: monospace;"
+            "background: transparent; border: none;");
+        searchLayout->addWidget(searchEdit_, 1);
+        searchLayout->addWidget(searchRegexBtn_);
+        searchLayout->addWidget(searchCount_);
+        searchLayout->addWidget(prevBtn);
+        searchLayout->addWidget(nextBtn);
+        searchBar_->setVisible(false);
+        vbox->addWidget(searchBar_);
+
         // ── Stacked body ──────────────────────────────────────────────────────
         stack_ = new QStackedWidget(this);
         vbox->addWidget(stack_, 1);
@@ -156,204 +346,370 @@ private:
         // Page 0: placeholder shown when unconfigured
         auto* placeholder = new QWidget(stack_);
         auto* phLayout = new QVBoxLayout(placeholder);
-        auto* phLabel = new QLabel(
-            "No log source configured.\nClick \u2699 to set up.", placeholder);
-        phLabel->setAlignment(Qt::AlignCenter);
-        phLabel->setStyleSheet(
+        placeholderLabel_ = new QLabel(kUnconfigured, placeholder);
+        placeholderLabel_->setAlignment(Qt::AlignCenter);
+        placeholderLabel_->setStyleSheet(
             "color: #404060; font-size: 12px; background: transparent;");
-        phLayout->addWidget(phLabel);
+        phLayout->addWidget(placeholderLabel_);
         stack_->addWidget(placeholder);   // index 0
 
         // Page 1: the log view
-        logView_ = new QPlainTextEdit(stack_);
-        logView_->setReadOnly(true);
-        logView_->setLineWrapMode(QPlainTextEdit::NoWrap);
-        logView_->setMaximumBlockCount(500);  // updated in applySource()
+        logView_ = new LogView(stack_);
+        logView_->setMaxLines(500);          // updated in applySource()
         stack_->addWidget(logView_);          // index 1
 
+        // Page 2: scrollback through the whole file, from the on-disk index
+        auto* history       = new QWidget(stack_);
+        auto* historyLayout = new QVBoxLayout(history);
+        historyLayout->setContentsMargins(0, 0, 0, 0);
+        historyLayout->setSpacing(0);
+        auto* jumpBar       = new QWidget(history);
+        auto* jumpLayout    = new QHBoxLayout(jumpBar);
+        jumpLayout->setContentsMargins(8, 2, 8, 2);
+        jumpEdit_ = new QLineEdit(jumpBar);
+        jumpEdit_->setPlaceholderText("jump to: 2h ago, 2026-10-14 09:00");
+        jumpEdit_->setStyleSheet(kFilterStyle);
+        historyStatus_ = new QLabel(jumpBar);
+        historyStatus_->setStyleSheet("color: #506080; font-size: 10px; font-family: monospace;");
+        jumpLayout->addWidget(jumpEdit_, 1);
+        jumpLayout->addWidget(historyStatus_);
+        scrollback_ = new ScrollbackView(history);
+        historyLayout->addWidget(jumpBar);
+        historyLayout->addWidget(scrollback_, 1);
+        stack_->addWidget(history);           // index 2
+
+        // With filtering at the source the reader restarts with the new
+        // filter, so wait for typing to settle
+        resourceTimer_ = new QTimer(this);
+        resourceTimer_->setSingleShot(true);
+        resourceTimer_->setInterval(500);
+        connect(resourceTimer_, &QTimer::timeout, this, &LogTailDisplay::applySource);
+
         connect(configBtn_, &QPushButton::clicked, this, &LogTailDisplay::openConfig);
+        connect(filterEdit_, &QLineEdit::textChanged, this, &LogTailDisplay::applyFilter);
+        connect(regexBtn_,   &QToolButton::toggled,   this, &LogTailDisplay::applyFilter);
+        connect(excludeBtn_, &QToolButton::toggled,   this, &LogTailDisplay::applyFilter);
+        connect(levelBox_, &QComboBox::currentIndexChanged, this, &LogTailDisplay::applyFilter);
+        metricsTimer_ = new QTimer(this);
+        metricsTimer_->setInterval(1000);
+        connect(metricsTimer_, &QTimer::timeout, this, &LogTailDisplay::sampleMetrics);
+        connect(logView_, &LogView::painted, this, [this]() {
+            if (noticedNs_ == 0) return;
+            worstLatencyNs_ = qMax(worstLatencyNs_, monotonicNs() - noticedNs_);
+            noticedNs_      = 0;
+        });
+
+        connect(historyBtn_, &QToolButton::toggled, this, &LogTailDisplay::showScrollback);
+        connect(jsonBtn_,    &QToolButton::toggled, this, &LogTailDisplay::applyProjection);
+        connect(scrollback_, &ScrollbackView::status, historyStatus_, &QLabel::setText);
+        connect(jumpEdit_, &QLineEdit::returnPressed, this, &LogTailDisplay::jumpToTime);
+        connect(scrollback_, &ScrollbackView::jumped, this, &LogTailDisplay::markJump);
+
+        // Searching restarts the scan, so wait for typing to settle
+        searchTimer_ = new QTimer(this);
+        searchTimer_->setSingleShot(true);
+        searchTimer_->setInterval(200);
+        connect(searchTimer_, &QTimer::timeout, this, &LogTailDisplay::applySearch);
+        connect(searchEdit_, &QLineEdit::textChanged, searchTimer_, qOverload<>(&QTimer::start));
+        connect(searchRegexBtn_, &QToolButton::toggled, this, &LogTailDisplay::applySearch);
+        connect(searchEdit_, &QLineEdit::returnPressed, this, [this]() {
+            findNext(QGuiApplication::keyboardModifiers() & Qt::ShiftModifier);
+        });
+        connect(prevBtn, &QToolButton::clicked, this, [this]() { findNext(true); });
+        connect(nextBtn, &QToolButton::clicked, this, [this]() { findNext(false); });
+        connect(logView_, &LogView::searchProgress, this,
+                [this](qsizetype current, qsizetype total, bool done) {
+                    if (stack_->currentIndex() == 1) showSearchProgress(current, total, done);
+                });
+        connect(scrollback_, &ScrollbackView::searchProgress, this,
+                [this](qsizetype current, qsizetype total, bool done) {
+                    if (stack_->currentIndex() == 2) showSearchProgress(current, total, done);
+                });
+        // Save and copy results stand in for the source name for a moment
+        noticeTimer_ = new QTimer(this);
+        noticeTimer_->setSingleShot(true);
+        noticeTimer_->setInterval(4000);
+        connect(noticeTimer_, &QTimer::timeout, this, &LogTailDisplay::updateSourceLabel);
+        connect(logView_, &LogView::exported, this, [this](const QString& message, bool ok) {
+            sourceLabel_->setText(ok ? message : "⚠ " + message);
+            noticeTimer_->start();
+        });
+
+        auto* findKey = new QShortcut(QKeySequence::Find, this);
+        findKey->setContext(Qt::WidgetWithChildrenShortcut);
+        connect(findKey, &QShortcut::activated, this, &LogTailDisplay::openSearch);
+        auto* escKey = new QShortcut(Qt::Key_Escape, searchBar_);
+        escKey->setContext(Qt::WidgetWithChildrenShortcut);
+        connect(escKey, &QShortcut::activated, this, &LogTailDisplay::closeSearch);
     }
 
-    // ── Source management ─────────────────────────────────────────────────────
-    void stopSource() {
-        if (watcher_) {
-            watcher_->removePaths(watcher_->files());
-            delete watcher_;
-            watcher_ = nullptr;
+    // ── Metrics ───────────────────────────────────────────────────────────────
+    void sampleMetrics() {
+        if (!source_) return;
+        const IngestMetrics m = sampler_.sample(
+            source_->counters(), source_->store().evicted(), source_->pendingLines(),
+            logView_->renderNs(), std::exchange(worstLatencyNs_, 0));
+        const QJsonObject json = m.toJson();
+        severityGraph_->push(m.severities);
+        if (showMetrics_) {
+            metricsLabel_->setText(m.summary());
+            metricsLabel_->setToolTip(QString::fromUtf8(QJsonDocument(json).toJson()));
         }
-        if (process_) {
-            process_->kill();
-            process_->waitForFinished(500);
-            delete process_;
-            process_ = nullptr;
+        const qint64 dropped = source_->counters().overflowed.load(std::memory_order_relaxed);
+        dropLabel_->setVisible(dropped > 0);
+        if (dropped > 0) {
+            dropLabel_->setText(QString("⚠ %1 dropped").arg(dropped));
+            dropLabel_->setToolTip(
+                "Lines that arrived faster than they could be shown and were\n"
+                "dropped, sampled away or collapsed, per the overload setting");
         }
+        emit metricsUpdated(json);
     }
 
-    void applySource() {
-        stopSource();
-        updateSourceLabel();
-        logView_->setMaximumBlockCount(config_.maxLines);
-        logView_->clear();
-
-        if (config_.source == LogTailConfig::Source::None) {
-            stack_->setCurrentIndex(0);
-            return;
-        }
-
-        stack_->setCurrentIndex(1);
+    // ── Scrollback ────────────────────────────────────────────────────────────
+    // Only a single plain file can be indexed
+    bool canScrollBack() const {
+        if (config_.source != LogTailConfig::Source::File) return false;
+        const QString path = config_.filePath.trimmed();
+        return !path.isEmpty() && !path.contains(QLatin1Char(';')) &&
+               !path.contains(QRegularExpression("[*?\\[]"));
+    }
 
-        if (config_.source == LogTailConfig::Source::File) {
-            startFileTail();
+    void showScrollback(bool on) {
+        if (on && canScrollBack()) {
+            scrollback_->open(config_.filePath.trimmed());
+            stack_->setCurrentIndex(2);
         } else {
-            startJournalctl();
+            scrollback_->close();
+            historyStatus_->clear();
+            stack_->setCurrentIndex(config_.source == LogTailConfig::Source::None ? 0 : 1);
         }
+        // The search follows the page on show
+        applySearch();
     }
 
-    void updateSourceLabel() {
-        switch (config_.source) {
-            case LogTailConfig::Source::File:
-                sourceLabel_->setText(QFileInfo(config_.filePath).fileName());
-                break;
-            case LogTailConfig::Source::Journalctl:
-                sourceLabel_->setText(
-                    config_.journalUnit.isEmpty()
-                        ? "journalctl"
-                        : QString("journalctl -u %1").arg(config_.journalUnit));
-                break;
-            default:
-                sourceLabel_->setText("not configured");
-                break;
+    // Accepts "<n>s|m|h|d [ago]" or a timestamp in any form parseTimestamp() knows
+    void jumpToTime() {
+        const QString text = jumpEdit_->text().trimmed();
+        static const QRegularExpression relative(R"(^(\d+)\s*([smhd])\w*(\s+ago)?$)");
+        qint64 ms = -1;
+        if (const auto m = relative.match(text); m.hasMatch()) {
+            static const QHash<QChar, qint64> unit = {
+                {'s', 1000}, {'m', 60'000}, {'h', 3'600'000}, {'d', 86'400'000}};
+            // parseTimestamp() returns UTC for zoned and local stamps alike
+            ms = QDateTime::currentMSecsSinceEpoch()
+                 - m.captured(1).toLongLong() * unit.value(m.captured(2).at(0));
+        } else {
+            ms = parseTimestamp(text.toUtf8());
         }
+        // A started jump reports back through markJump()
+        if (ms < 0 || !scrollback_->jumpTo(ms)) markJump(false);
     }
 
-    // ── File tail ─────────────────────────────────────────────────────────────
-    void startFileTail() {
-        QFile f(config_.filePath);
-        if (!f.open(QFile::ReadOnly)) {
-            appendLine(QString("Cannot open: %1").arg(config_.filePath), QColor("#ff5555"));
-            filePos_ = 0;
-            return;
-        }
-
-        // Seed with up to the last ~100 KB so we don't read gigabyte-sized files
-        const qint64 fileSize = f.size();
-        const qint64 seekTo   = qMax(qint64(0), fileSize - qint64(100 * 1024));
-        f.seek(seekTo);
-
-        QStringList lines;
-        for (const QByteArray& raw : f.readAll().split('\n')) {
-            const QString line = QString::fromUtf8(raw).trimmed();
-            if (!line.isEmpty()) lines.append(line);
-        }
-
-        // Keep only the last maxLines entries
-        if (lines.size() > config_.maxLines)
-            lines = lines.mid(lines.size() - config_.maxLines);
+    void markJump(bool found) {
+        jumpEdit_->setStyleSheet(found ? kFilterStyle
+                                       : kFilterStyle + QStringLiteral("QLineEdit { border-color: #aa3344; }"));
+    }
 
-        appendLines(lines);
-        filePos_ = fileSize;
+    // ── Filtering ─────────────────────────────────────────────────────────────
+    void applyFilter() {
+        config_.filter = {
+            .pattern  = filterEdit_->text(),
+            .regex    = regexBtn_->isChecked(),
+            .exclude  = excludeBtn_->isChecked(),
+            .minLevel = levelBox_->currentIndex(),
+        };
+        // Compiled once here; the view and its worker share the result
+        auto filter = std::make_shared<const LineFilter>(config_.filter);
+        filterEdit_->setStyleSheet(filter->isValid()
+            ? kFilterStyle
+            : kFilterStyle + QStringLiteral("QLineEdit { border-color: #aa3344; }"));
+        logView_->setFilter(std::move(filter));
+        if (config_.filterAtSource && source_) resourceTimer_->start();
+    }
 
-        watcher_ = new QFileSystemWatcher(this);
-        watcher_->addPath(config_.filePath);
-        connect(watcher_, &QFileSystemWatcher::fileChanged,
-                this, &LogTailDisplay::onFileChanged);
+    // ── Search ────────────────────────────────────────────────────────────────
+    void openSearch() {
+        searchBar_->setVisible(true);
+        searchEdit_->setFocus();
+        searchEdit_->selectAll();
     }
 
-    void onFileChanged(const QString& path) {
-        QFile f(path);
-        if (!f.open(QFile::ReadOnly)) return;
+    void closeSearch() {
+        searchTimer_->stop();
+        searchBar_->setVisible(false);
+        logView_->setSearch(nullptr);
+        scrollback_->setSearch(nullptr);
+        searchCount_->clear();
+        (stack_->currentIndex() == 2 ? static_cast<QWidget*>(scrollback_) : logView_)->setFocus();
+    }
 
-        const qint64 currentSize = f.size();
-        if (currentSize < filePos_) {
-            // Truncation / log rotation
-            filePos_ = 0;
-            logView_->clear();
-            appendLine("─── log rotated ───", QColor("#6272a4"));
+    // Only the page on show is searched; the other one drops its hits
+    void applySearch() {
+        searchTimer_->stop();
+        std::shared_ptr<const LineFilter> query;
+        bool valid = true;
+        if (searchBar_->isVisible() && !searchEdit_->text().isEmpty()) {
+            query = std::make_shared<const LineFilter>(LineFilter::Spec{
+                .pattern = searchEdit_->text(),
+                .regex   = searchRegexBtn_->isChecked(),
+            });
+            valid = query->isValid();
+            if (!valid) query.reset();
         }
+        searchEdit_->setStyleSheet(valid
+            ? kFilterStyle
+            : kFilterStyle + QStringLiteral("QLineEdit { border-color: #aa3344; }"));
+        const bool history = stack_->currentIndex() == 2;
+        logView_->setSearch(history ? nullptr : query);
+        scrollback_->setSearch(history ? query : nullptr);
+        if (!query) searchCount_->clear();
+    }
 
-        if (filePos_ == currentSize) return;
-
-        f.seek(filePos_);
-        const QByteArray newData = f.readAll();
-        filePos_ = f.pos();
+    void findNext(bool backward) {
+        // Enter right after typing searches first
+        if (searchTimer_->isActive()) applySearch();
+        if (stack_->currentIndex() == 2) scrollback_->findNext(backward);
+        else                             logView_->findNext(backward);
+    }
 
-        QStringList lines;
-        for (const QByteArray& raw : newData.split('\n')) {
-            const QString line = QString::fromUtf8(raw).trimmed();
-            if (!line.isEmpty()) lines.append(line);
-        }
-        appendLines(lines);
+    void showSearchProgress(qsizetype current, qsizetype total, bool done) {
+        if (searchEdit_->text().isEmpty()) return;
+        const QString more = done ? QString() : QStringLiteral("…");
+        if (done && total == 0) searchCount_->setText("no matches");
+        else if (current > 0)   searchCount_->setText(QString("%1 / %2%3").arg(current).arg(total).arg(more));
+        else                    searchCount_->setText(QString("%1%2").arg(total).arg(more));
+    }
 
-        // QFileSystemWatcher may stop tracking after some editors replace files
-        if (!watcher_->files().contains(path))
-            watcher_->addPath(path);
+    // JSON lines are only parsed for the rows being painted
+    void applyProjection() {
+        config_.jsonColumns = jsonBtn_->isChecked();
+        logView_->setProjection(config_.jsonColumns
+            ? std::make_shared<const JsonProjection>(config_.jsonKeys)
+            : nullptr);
     }
 
-    // ── journalctl ────────────────────────────────────────────────────────────
-    void startJournalctl() {
-        QStringList args = {"-f", "-n", "50", "--no-pager", "--output=short-iso"};
-        if (!config_.journalUnit.isEmpty())
-            args << "-u" << config_.journalUnit;
-
-        process_ = new QProcess(this);
-        connect(process_, &QProcess::readyReadStandardOutput,
-                this, &LogTailDisplay::onJournalOutput);
-        connect(process_, &QProcess::errorOccurred, this,
-                [this](QProcess::ProcessError) {
-                    appendLine("journalctl: failed to start — is systemd available?",
-                               QColor("#ff5555"));
-                });
-        process_->start("journalctl", args);
+    // ── Source management ─────────────────────────────────────────────────────
+    void stopSource() {
+        if (!source_) return;
+        logView_->setStore(nullptr);
+        disconnect(source_.get(), nullptr, logView_, nullptr);
+        disconnect(source_.get(), nullptr, this, nullptr);
+        source_->removeViewer(this);
+        source_.reset();
+        metricsTimer_->stop();
+        metricsLabel_->clear();
+        severityGraph_->clear();
+        dropLabel_->clear();
+        dropLabel_->setVisible(false);
+        watchLabel_->setVisible(false);
     }
 
-    void onJournalOutput() {
-        QStringList lines;
-        while (process_->canReadLine()) {
-            const QString line = QString::fromUtf8(process_->readLine()).trimmed();
-            if (!line.isEmpty()) lines.append(line);
+    void updateWatchLabel() {
+        const bool file = source_ && config_.source == LogTailConfig::Source::File;
+        watchLabel_->setVisible(file);
+        if (!file) return;
+        if (source_->pollingFiles() > 0) {
+            watchLabel_->setText("poll");
+            watchLabel_->setToolTip(QString(
+                "Polling for changes (%1): every %2 ms while lines arrive,\n"
+                "backing off to every %3 s while the file is idle")
+                .arg(source_->pollingReason()).arg(qMax(config_.flushMs, FileTailWorker::kPollMinMs))
+                .arg(FileTailWorker::kPollMaxMs / 1000));
+        } else {
+            watchLabel_->setText("inotify");
+            watchLabel_->setToolTip("Following changes through inotify");
         }
-        appendLines(lines);
     }
 
-    // ── Text insertion helpers ────────────────────────────────────────────────
-    void appendLines(const QStringList& lines) {
-        if (lines.isEmpty()) return;
+    // Shows the configured source as loading and starts it once the widget
+    // is on screen and its turn comes; see queueActivation().
+    void deferSource() {
+        if (config_.source == LogTailConfig::Source::None) {
+            applySource();
+            return;
+        }
+        resourceTimer_->stop();
+        stopSource();
+        historyBtn_->setChecked(false);
+        historyBtn_->setVisible(false);
+        updateSourceLabel();
+        placeholderLabel_->setText("Loading…");
+        stack_->setCurrentIndex(0);
+        deferred_ = true;
+        if (isVisible()) queueSource();
+    }
 
-        auto* sb = logView_->verticalScrollBar();
-        const bool atBottom = sb->value() >= sb->maximum() - 4;
+    void queueSource() {
+        if (queued_) return;
+        queued_ = true;
+        queueActivation(this, [this]() {
+            queued_ = false;
+            // Hidden again while waiting: showEvent() queues it anew
+            if (deferred_ && isVisible()) applySource();
+        });
+    }
 
-        logView_->setUpdatesEnabled(false);
-        QTextCursor cursor(logView_->document());
-        cursor.movePosition(QTextCursor::End);
-        cursor.beginEditBlock();
+    void applySource() {
+        deferred_ = queued_ = false;
+        resourceTimer_->stop();
+        stopSource();
+        historyBtn_->setChecked(false);
+        historyBtn_->setVisible(canScrollBack());
+        updateSourceLabel();
+        logView_->setMaxLines(config_.maxLines);
 
-        for (const QString& line : lines) {
-            if (cursor.position() > 0) cursor.insertBlock();
-            QTextCharFormat fmt;
-            fmt.setForeground(colorForLine(line));
-            cursor.setCharFormat(fmt);
-            cursor.insertText(line);
+        if (config_.source == LogTailConfig::Source::None) {
+            placeholderLabel_->setText(kUnconfigured);
+            stack_->setCurrentIndex(0);
+            return;
         }
 
-        cursor.endEditBlock();
-        logView_->setUpdatesEnabled(true);
+        stack_->setCurrentIndex(1);
 
-        if (atBottom) {
-            QMetaObject::invokeMethod(this, [this, sb]() {
-                sb->setValue(sb->maximum());
-            }, Qt::QueuedConnection);
-        }
+        // Widgets showing the same file or unit share one reader and store
+        source_ = TailSource::acquire(config_);
+        connect(source_.get(), &TailSource::appended, logView_, &LogView::storeAppended);
+        connect(source_.get(), &TailSource::cleared,  logView_, &LogView::storeCleared);
+        // Latency runs from the reader noticing a change to the next paint
+        connect(source_.get(), &TailSource::appended, this, [this]() {
+            if (noticedNs_ == 0 && logView_->isVisible()) noticedNs_ = source_->lastNoticedNs();
+        });
+        connect(source_.get(), &TailSource::watchModeChanged, this,
+                &LogTailDisplay::updateWatchLabel);
+        updateWatchLabel();
+        logView_->setStore(&source_->store());
+        source_->addViewer(this, config_.maxLines, config_.flushMs);
+
+        sampler_.reset();
+        sampleMetrics();   // baseline for the first interval
+        metricsTimer_->start();
     }
 
-    void appendLine(const QString& line, QColor color) {
-        appendLines({line});
-        // Override color on the last block
-        QTextCursor cursor(logView_->document());
-        cursor.movePosition(QTextCursor::End);
-        cursor.select(QTextCursor::BlockUnderCursor);
-        QTextCharFormat fmt;
-        fmt.setForeground(color);
-        cursor.mergeCharFormat(fmt);
+    void updateSourceLabel() {
+        noticeTimer_->stop();
+        switch (config_.source) {
+            case LogTailConfig::Source::File: {
+                QStringList names;
+                for (const QString& entry : config_.filePath.split(';', Qt::SkipEmptyParts))
+                    names.append(QFileInfo(entry.trimmed()).fileName());
+                sourceLabel_->setText(names.join(", "));
+                break;
+            }
+            case LogTailConfig::Source::Remote:
+                sourceLabel_->setText(QString("%1:%2").arg(
+                    config_.remoteHost, QFileInfo(config_.remotePath).fileName()));
+                break;
+            case LogTailConfig::Source::Journalctl:
+                sourceLabel_->setText(
+                    config_.journalUnit.isEmpty()
+                        ? "journalctl"
+                        : QString("journalctl -u %1").arg(config_.journalUnit));
+                break;
+            default:
+                sourceLabel_->setText("not configured");
+                break;
+        }
     }
 
     // ── Config dialog ─────────────────────────────────────────────────────────
@@ -368,9 +724,12 @@ private:
         // Source type radios
         auto* fileRadio    = new QRadioButton("File", dlg);
         auto* journalRadio = new QRadioButton("journalctl (systemd)", dlg);
+        auto* remoteRadio  = new QRadioButton("Remote file over SSH", dlg);
 
         if (config_.source == LogTailConfig::Source::Journalctl)
             journalRadio->setChecked(true);
+        else if (config_.source == LogTailConfig::Source::Remote)
+            remoteRadio->setChecked(true);
         else
             fileRadio->setChecked(true);
 
@@ -379,6 +738,8 @@ private:
         auto* fileLayout = new QHBoxLayout(fileRow);
         fileLayout->setContentsMargins(16, 0, 0, 0);
         auto* fileEdit  = new QLineEdit(config_.filePath, fileRow);
+        fileEdit->setToolTip("A file, a glob such as /var/log/app/*.log, or several separated by ';'.\n"
+                             "Multiple files are merged into one stream ordered by timestamp.");
         auto* browseBtn = new QPushButton("Browse…", fileRow);
         fileLayout->addWidget(new QLabel("Path:", fileRow));
         fileLayout->addWidget(fileEdit, 1);
@@ -393,48 +754,154 @@ private:
         journalLayout->addWidget(new QLabel("Unit:", journalRow));
         journalLayout->addWidget(unitEdit, 1);
 
+        // Remote host, path and agent
+        auto* remoteRow    = new QWidget(dlg);
+        auto* remoteLayout = new QGridLayout(remoteRow);
+        remoteLayout->setContentsMargins(16, 0, 0, 0);
+        auto* hostEdit  = new QLineEdit(config_.remoteHost, remoteRow);
+        hostEdit->setPlaceholderText("user@host");
+        auto* remotePathEdit = new QLineEdit(config_.remotePath, remoteRow);
+        remotePathEdit->setPlaceholderText("/var/log/app.log");
+        auto* agentEdit = new QLineEdit(config_.remoteAgent, remoteRow);
+        agentEdit->setToolTip("Command that starts logtail-agent on the host. Without it\n"
+                              "the widget falls back to tail -F, which reseeds on reconnect.");
+        remoteLayout->addWidget(new QLabel("Host:", remoteRow),  0, 0);
+        remoteLayout->addWidget(hostEdit,                        0, 1);
+        remoteLayout->addWidget(new QLabel("Path:", remoteRow),  1, 0);
+        remoteLayout->addWidget(remotePathEdit,                  1, 1);
+        remoteLayout->addWidget(new QLabel("Agent:", remoteRow), 2, 0);
+        remoteLayout->addWidget(agentEdit,                       2, 1);
+
+        // Extra JSON keys
+        auto* jsonRow  = new QHBoxLayout();
+        auto* jsonEdit = new QLineEdit(config_.jsonKeys.join(", "), dlg);
+        jsonEdit->setPlaceholderText("e.g. request_id, user, duration_ms");
+        jsonEdit->setToolTip("Top-level keys shown after the message when {} is on");
+        jsonRow->addWidget(new QLabel("JSON keys:", dlg));
+        jsonRow->addWidget(jsonEdit, 1);
+
         // Buffer size
         auto* bufRow    = new QHBoxLayout();
         auto* spinBox   = new QSpinBox(dlg);
-        spinBox->setRange(50, 5000);
+        spinBox->setRange(50, 200000);
         spinBox->setValue(config_.maxLines);
         spinBox->setSuffix(" lines");
         bufRow->addWidget(new QLabel("Buffer size:", dlg));
         bufRow->addWidget(spinBox);
         bufRow->addStretch();
 
+        // Overload policy
+        auto* overloadRow = new QHBoxLayout();
+        auto* overloadBox = new QComboBox(dlg);
+        overloadBox->addItems({"drop the oldest lines",
+                               QString("keep 1 in %1 lines").arg(IngestQueue::kSampleEvery),
+                               "collapse into \"lines skipped\" markers"});   // IngestQueue::Policy
+        overloadBox->setCurrentIndex(int(config_.overload));
+        overloadBox->setToolTip("What gives when more than a buffer's worth of lines\n"
+                                "arrives between two refreshes");
+        overloadRow->addWidget(new QLabel("When overloaded:", dlg));
+        overloadRow->addWidget(overloadBox, 1);
+
+        // Repeated lines
+        auto* dedupRow = new QHBoxLayout();
+        auto* dedupBox = new QComboBox(dlg);
+        dedupBox->addItems({"keep every line", "collapse identical lines",
+                            "collapse lines differing only in numbers"});   // LineStore::Dedup
+        dedupBox->setCurrentIndex(int(config_.dedup));
+        dedupBox->setToolTip(QString("A line repeating one of the last %1 lines is shown as a\n"
+                                     "×N counter on that line instead of a row of its own")
+                                 .arg(LineStore::kDedupWindow));
+        dedupRow->addWidget(new QLabel("Repeated lines:", dlg));
+        dedupRow->addWidget(dedupBox, 1);
+
+        // Refresh interval
+        auto* flushRow  = new QHBoxLayout();
+        auto* flushSpin = new QSpinBox(dlg);
+        flushSpin->setRange(16, 1000);
+        flushSpin->setValue(config_.flushMs);
+        flushSpin->setSuffix(" ms");
+        flushSpin->setToolTip("How often new lines are drawn; bursts are batched in between");
+        flushRow->addWidget(new QLabel("Refresh interval:", dlg));
+        flushRow->addWidget(flushSpin);
+        flushRow->addStretch();
+
+        auto* stitchBox = new QCheckBox("Start with older lines from rotated files", dlg);
+        stitchBox->setChecked(config_.stitchRotated);
+        stitchBox->setToolTip(
+            "If the file has fewer lines than the buffer holds, fill it up from\n"
+            "<file>.1, <file>.2.gz, <file>.3.zst ... newest first. Single files only.");
+
+        auto* sourceFilterBox = new QCheckBox("Drop filtered lines at the source", dlg);
+        sourceFilterBox->setChecked(config_.filterAtSource);
+        sourceFilterBox->setToolTip(
+            "Lines the header filter rejects are never stored. In journal mode the\n"
+            "severity threshold and pattern are passed to the journal itself.\n"
+            "Changing the filter then reloads the source.");
+
+        auto* metricsBox = new QCheckBox("Show ingestion metrics in the header", dlg);
+        metricsBox->setChecked(showMetrics_);
+        metricsBox->setToolTip(
+            "Lines and bytes per second, read and parse cost, render time,\n"
+            "change-to-paint latency, queue depth and dropped lines");
+
         auto* buttons = new QDialogButtonBox(
             QDialogButtonBox::Ok | QDialogButtonBox::Cancel, dlg);
 
         vbox->addWidget(fileRadio);
         vbox->addWidget(fileRow);
+        vbox->addWidget(stitchBox);
         vbox->addWidget(journalRadio);
         vbox->addWidget(journalRow);
+        vbox->addWidget(remoteRadio);
+        vbox->addWidget(remoteRow);
         vbox->addLayout(bufRow);
+        vbox->addLayout(flushRow);
+        vbox->addLayout(overloadRow);
+        vbox->addLayout(dedupRow);
+        vbox->addLayout(jsonRow);
+        vbox->addWidget(sourceFilterBox);
+        vbox->addWidget(metricsBox);
         vbox->addWidget(buttons);
 
         auto syncVisibility = [&]() {
             fileRow->setEnabled(fileRadio->isChecked());
+            stitchBox->setEnabled(fileRadio->isChecked());
             journalRow->setEnabled(journalRadio->isChecked());
+            remoteRow->setEnabled(remoteRadio->isChecked());
         };
         syncVisibility();
 
         connect(fileRadio,    &QRadioButton::toggled, dlg, [syncVisibility](bool) { syncVisibility(); });
         connect(journalRadio, &QRadioButton::toggled, dlg, [syncVisibility](bool) { syncVisibility(); });
+        connect(remoteRadio,  &QRadioButton::toggled, dlg, [syncVisibility](bool) { syncVisibility(); });
         connect(browseBtn, &QPushButton::clicked, dlg, [&]() {
-            const QString p = QFileDialog::getOpenFileName(dlg, "Choose Log File");
-            if (!p.isEmpty()) fileEdit->setText(p);
+            const QStringList p = QFileDialog::getOpenFileNames(dlg, "Choose Log Files");
+            if (!p.isEmpty()) fileEdit->setText(p.join("; "));
         });
         connect(buttons, &QDialogButtonBox::accepted, dlg, &QDialog::accept);
         connect(buttons, &QDialogButtonBox::rejected, dlg, &QDialog::reject);
 
         if (dlg->exec() == QDialog::Accepted) {
-            config_.source = fileRadio->isChecked()
-                ? LogTailConfig::Source::File
-                : LogTailConfig::Source::Journalctl;
+            config_.source = fileRadio->isChecked()   ? LogTailConfig::Source::File
+                           : remoteRadio->isChecked() ? LogTailConfig::Source::Remote
+                                                      : LogTailConfig::Source::Journalctl;
             config_.filePath    = fileEdit->text().trimmed();
             config_.journalUnit = unitEdit->text().trimmed();
+            config_.remoteHost  = hostEdit->text().trimmed();
+            config_.remotePath  = remotePathEdit->text().trimmed();
+            config_.remoteAgent = agentEdit->text().trimmed();
             config_.maxLines    = spinBox->value();
+            config_.flushMs     = flushSpin->value();
+            config_.filterAtSource = sourceFilterBox->isChecked();
+            config_.stitchRotated  = stitchBox->isChecked();
+            config_.overload       = IngestQueue::Policy(overloadBox->currentIndex());
+            config_.dedup          = LineStore::Dedup(dedupBox->currentIndex());
+            config_.jsonKeys.clear();
+            for (const QString& key : jsonEdit->text().split(',', Qt::SkipEmptyParts))
+                if (!key.trimmed().isEmpty()) config_.jsonKeys.append(key.trimmed());
+            applyProjection();
+            showMetrics_ = metricsBox->isChecked();
+            metricsLabel_->setVisible(showMetrics_);
             applySource();
         }
         dlg->deleteLater();
@@ -444,11 +911,37 @@ private:
     LogTailConfig        config_;
     QLabel*              sourceLabel_ = nullptr;
     QPushButton*         configBtn_   = nullptr;
+    QLineEdit*           filterEdit_  = nullptr;
+    QToolButton*         regexBtn_    = nullptr;
+    QToolButton*         excludeBtn_  = nullptr;
+    QComboBox*           levelBox_    = nullptr;
+    QTimer*              resourceTimer_ = nullptr;
+    QToolButton*         historyBtn_  = nullptr;
+    QToolButton*         jsonBtn_     = nullptr;
+    QLineEdit*           jumpEdit_    = nullptr;
+    QLabel*              historyStatus_ = nullptr;
+    ScrollbackView*      scrollback_  = nullptr;
+    QWidget*             searchBar_   = nullptr;
+    QLineEdit*           searchEdit_  = nullptr;
+    QToolButton*         searchRegexBtn_ = nullptr;
+    QLabel*              searchCount_ = nullptr;
+    QTimer*              searchTimer_ = nullptr;
+    QTimer*              noticeTimer_ = nullptr;
+    QLabel*              metricsLabel_ = nullptr;
+    QLabel*              dropLabel_    = nullptr;
+    QLabel*              watchLabel_   = nullptr;
+    SeverityGraph*       severityGraph_ = nullptr;
+    QTimer*              metricsTimer_ = nullptr;
+    IngestSampler        sampler_;
+    bool                 showMetrics_    = false;
+    qint64               noticedNs_      = 0;   // oldest change not painted yet
+    qint64               worstLatencyNs_ = 0;   // within the current interval
     QStackedWidget*      stack_       = nullptr;
-    QPlainTextEdit*      logView_     = nullptr;
-    QFileSystemWatcher*  watcher_     = nullptr;
-    QProcess*            process_     = nullptr;
-    qint64               filePos_     = 0;
+    QLabel*              placeholderLabel_ = nullptr;
+    bool                 deferred_    = false;   // configured, waiting to be shown
+    bool                 queued_      = false;   // in the activation queue
+    LogView*             logView_     = nullptr;
+    std::shared_ptr<TailSource> source_;
 };
 
 #include "LogTailWidget.moc"
@@ -461,6 +954,7 @@ void LogTailWidget::initialize(dashboard::WidgetContext* /*context*/) {}
 
 QWidget* LogTailWidget::createWidget(QWidget* parent) {
     display_ = new LogTailDisplay(parent);
+    connect(display_, &LogTailDisplay::metricsUpdated, this, &LogTailWidget::metricsUpdated);
     if (!pending_.isEmpty())
         display_->loadConfig(pending_);
     return display_;
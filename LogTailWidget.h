@@ -36,6 +36,11 @@ public:
     void deserialize(const QJsonObject& data) override;
     dashboard::WidgetMetadata metadata() const override;
 
+signals:
+    // Ingestion metrics for the widget's source, once a second; see
+    // IngestMetrics::toJson() for the keys.
+    void metricsUpdated(const QJsonObject& metrics);
+
 private:
     LogTailDisplay* display_  = nullptr;
     QJsonObject     pending_;
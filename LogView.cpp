@@ -0,0 +1,662 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "LogView.h"
+
+#include "IngestMetrics.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QContextMenuEvent>
+#include <QDateTime>
+#include <QDir>
+#include <QFileDialog>
+#include <QFontMetrics>
+#include <QKeyEvent>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QReadLocker>
+#include <QSaveFile>
+#include <QScrollBar>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace {
+
+const QColor kBackground("#0d1117");
+const QColor kSelection("#264f78");
+const QColor kExtraFields("#6272a4");
+const QColor kRepeatCount("#f1fa8c");
+const QColor kSearchHit(0xf1, 0xfa, 0x8c, 60);
+const QColor kCurrentHit(0xff, 0xb8, 0x6c, 110);
+constexpr int kMargin = 4;   // left padding, matches QPlainTextEdit's document margin
+// Rows a refilter job checks per read lock, so appends are never held up long
+constexpr qint64 kRefilterChunk = 4096;
+
+// Hands the lines in [from, upTo) that `filter` accepts (all with nullptr)
+// to `sink` as newline-terminated UTF-8, one chunk per read lock so appends
+// are never held up by the sink's I/O. Lines evicted meanwhile are skipped.
+// Returns the number of lines written, or -1 if the sink failed.
+qint64 exportLines(const LineStore* store, qint64 from, qint64 upTo, const LineFilter* filter,
+                   const std::function<bool(const QByteArray&)>& sink) {
+    QByteArray chunk;
+    qint64     written = 0;
+    for (qint64 id = from; id < upTo; ) {
+        chunk.clear();
+        {
+            QReadLocker locker(&store->lock());
+            const qint64 evicted = store->evicted();
+            const qint64 end = qMin(qMin(upTo, id + kRefilterChunk), evicted + store->size());
+            id = qMax(id, evicted);
+            if (id >= end) break;
+            for (; id < end; ++id) {
+                const qsizetype      row  = qsizetype(id - evicted);
+                const QByteArrayView line = store->line(row);
+                if (filter && !filter->accepts(line, store->severity(row))) continue;
+                chunk.append(line);
+                if (const quint32 n = store->repeats(row); n > 1)
+                    chunk.append(" ×").append(QByteArray::number(n));
+                chunk.append('\n');
+                ++written;
+            }
+        }
+        if (!chunk.isEmpty() && !sink(chunk)) return -1;
+    }
+    return written;
+}
+
+}  // namespace
+
+LogView::LogView(QWidget* parent) : QAbstractScrollArea(parent) {
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setFocusPolicy(Qt::StrongFocus);
+    viewport()->setCursor(Qt::IBeamCursor);
+    pool_.setMaxThreadCount(1);
+    updateMetrics();
+}
+
+LogView::~LogView() {
+    ++searchGeneration_;
+    cancelRefilter();
+    pool_.waitForDone();
+}
+
+void LogView::setStore(const LineStore* store) {
+    // A running refilter or search job reads the old store
+    ++searchGeneration_;
+    cancelRefilter();
+    pool_.waitForDone();
+    store_ = store;
+    storeCleared();
+    storeAppended();
+}
+
+void LogView::setMaxLines(int maxLines) {
+    window_ = qMax(1, maxLines);
+    storeCleared();
+    storeAppended();
+}
+
+void LogView::setFilter(std::shared_ptr<const LineFilter> filter) {
+    if (filter && filter->isTrivial()) filter.reset();
+    if (!filter && !filter_) return;
+
+    cancelRefilter();
+    filter_ = std::move(filter);
+    // Hits are only counted among shown lines
+    if (search_) startSearch();
+    if (filter_) {
+        // The old matches stay on screen until the job reports back
+        startRefilter();
+        return;
+    }
+
+    const bool   atBottom = isAtBottom();
+    const qint64 top      = lineCount() > 0 ? idAt(verticalScrollBar()->value()) : 0;
+    matches_.clear();
+    for (qsizetype row = 0; row < lineCount(); ++row)
+        widest_ = qMax(widest_, lineAt(row).size());
+    updateScrollBars();
+    verticalScrollBar()->setValue(atBottom ? verticalScrollBar()->maximum() : int(rowOf(top)));
+    viewport()->update();
+}
+
+void LogView::setProjection(std::shared_ptr<const JsonProjection> projection) {
+    projection_ = std::move(projection);
+    viewport()->update();
+}
+
+void LogView::setSearch(std::shared_ptr<const LineFilter> query) {
+    if (query && query->isTrivial()) query.reset();
+    search_ = std::move(query);
+    startSearch();
+    viewport()->update();
+}
+
+void LogView::startSearch() {
+    const quint64 generation = ++searchGeneration_;
+    hits_.clear();
+    currentHit_ = -1;
+    searchUpTo_ = seen_;   // storeAppended() checks the rest
+    searching_  = search_ && store_;
+    if (!searching_) {
+        reportSearch();
+        return;
+    }
+
+    const qint64     from   = firstId();
+    const qint64     upTo   = searchUpTo_;
+    const LineStore* store  = store_;
+    std::shared_ptr<const LineFilter> query  = search_;
+    std::shared_ptr<const LineFilter> filter = filter_;
+
+    pool_.start([this, generation, from, upTo, store, query, filter] {
+        // Hits are posted a chunk at a time, so the count grows as the scan goes
+        for (qint64 id = from; id < upTo; ) {
+            if (searchGeneration_ != generation) return;
+            std::vector<qint64> ids;
+            {
+                QReadLocker locker(&store->lock());
+                const qint64 evicted = store->evicted();
+                const qint64 end = qMin(qMin(upTo, id + kRefilterChunk), evicted + store->size());
+                id = qMax(id, evicted);
+                if (id >= end) break;
+                for (; id < end; ++id) {
+                    const qsizetype      row      = qsizetype(id - evicted);
+                    const QByteArrayView line     = store->line(row);
+                    const Severity       severity = store->severity(row);
+                    if ((!filter || filter->accepts(line, severity)) &&
+                        query->accepts(line, severity))
+                        ids.push_back(id);
+                }
+            }
+            if (ids.empty()) continue;
+            QMetaObject::invokeMethod(this, [this, generation, upTo, ids = std::move(ids)] {
+                addSearchHits(generation, upTo, ids, false);
+            }, Qt::QueuedConnection);
+        }
+        QMetaObject::invokeMethod(this, [this, generation, upTo] {
+            addSearchHits(generation, upTo, {}, true);
+        }, Qt::QueuedConnection);
+    });
+    reportSearch();
+}
+
+void LogView::addSearchHits(quint64 generation, qint64 upTo, const std::vector<qint64>& ids,
+                            bool done) {
+    if (generation != searchGeneration_ || upTo != searchUpTo_) return;
+
+    // Chunks arrive in order and below every hit found on arrival
+    const qint64 first = firstId();
+    auto from = std::lower_bound(ids.begin(), ids.end(), first);
+    if (from != ids.end()) {
+        hits_.insert(std::lower_bound(hits_.begin(), hits_.end(), *from), from, ids.end());
+        viewport()->update();
+    }
+    if (done) searching_ = false;
+    reportSearch();
+}
+
+bool LogView::isHit(qint64 id) const {
+    return std::binary_search(hits_.begin(), hits_.end(), id);
+}
+
+void LogView::findNext(bool backward) {
+    if (hits_.empty()) {
+        reportSearch();
+        return;
+    }
+    // From the selected hit, or else from the top of the view
+    qint64 from = currentHit_;
+    if (from < 0 || !isHit(from))
+        from = lineCount() > 0 ? idAt(verticalScrollBar()->value()) - (backward ? 0 : 1) : 0;
+
+    auto it = backward ? std::lower_bound(hits_.begin(), hits_.end(), from)
+                       : std::upper_bound(hits_.begin(), hits_.end(), from);
+    if (backward) it = it == hits_.begin() ? hits_.end() - 1 : it - 1;
+    else if (it == hits_.end()) it = hits_.begin();
+    currentHit_ = *it;
+
+    const qsizetype row     = rowOf(currentHit_);
+    const int       visible = qMax(1, viewport()->height() / lineHeight_);
+    auto*           sb      = verticalScrollBar();
+    if (row < sb->value() || row >= sb->value() + visible)
+        sb->setValue(int(qMax<qsizetype>(0, row - visible / 2)));
+    selAnchor_ = selEnd_ = currentHit_;
+    viewport()->update();
+    reportSearch();
+}
+
+void LogView::reportSearch() {
+    const qsizetype current = currentHit_ >= 0 && isHit(currentHit_)
+        ? qsizetype(std::lower_bound(hits_.begin(), hits_.end(), currentHit_) - hits_.begin()) + 1
+        : 0;
+    emit searchProgress(current, qsizetype(hits_.size()), !searching_);
+}
+
+void LogView::saveBuffer(const QString& path) {
+    if (!store_) return;
+    const LineStore* store = store_;
+    const qint64     from  = firstId();
+    const qint64     upTo  = seen_;
+    pool_.start([this, store, from, upTo, path] {
+        // Written next to the target and renamed over it once complete
+        QSaveFile file(path);
+        qint64 lines = -1;
+        if (file.open(QIODevice::WriteOnly)) {
+            lines = exportLines(store, from, upTo, nullptr, [&file](const QByteArray& chunk) {
+                return file.write(chunk) == chunk.size();
+            });
+            if (lines >= 0 && !file.commit()) lines = -1;
+        }
+        const QString message = lines >= 0
+            ? QString("saved %1 lines to %2").arg(lines).arg(QDir::toNativeSeparators(path))
+            : QString("cannot save %1: %2").arg(QDir::toNativeSeparators(path), file.errorString());
+        QMetaObject::invokeMethod(this, [this, message, ok = lines >= 0] {
+            emit exported(message, ok);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void LogView::copyShown() {
+    if (!store_) return;
+    const LineStore* store = store_;
+    const qint64     from  = firstId();
+    const qint64     upTo  = seen_;
+    std::shared_ptr<const LineFilter> filter = filter_;
+    pool_.start([this, store, from, upTo, filter] {
+        QByteArray text;
+        const qint64 lines = exportLines(store, from, upTo, filter.get(),
+                                         [&text](const QByteArray& chunk) {
+            text.append(chunk);
+            return true;
+        });
+        if (text.endsWith('\n')) text.chop(1);
+        // The clipboard wants UTF-16; this is the one conversion
+        QMetaObject::invokeMethod(this, [this, lines, text = std::move(text)] {
+            QApplication::clipboard()->setText(QString::fromUtf8(text));
+            emit exported(QString("copied %1 lines").arg(lines), true);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void LogView::startRefilter() {
+    if (!store_) return;
+    const quint64    generation = generation_;
+    const qint64     from       = firstId();
+    const qint64     upTo       = seen_;   // storeAppended() checks the rest
+    const LineStore* store      = store_;
+    std::shared_ptr<const LineFilter> filter = filter_;
+
+    pool_.start([this, generation, from, upTo, store, filter] {
+        std::vector<qint64> ids;
+        qsizetype           widest = 0;
+        for (qint64 id = from; id < upTo; ) {
+            if (generation_ != generation) return;
+
+            // Rows may have been evicted, or the store cleared, since the last chunk
+            QReadLocker locker(&store->lock());
+            const qint64 evicted = store->evicted();
+            const qint64 end     = qMin(qMin(upTo, id + kRefilterChunk), evicted + store->size());
+            id = qMax(id, evicted);
+            if (id >= end) break;
+            for (; id < end; ++id) {
+                const qsizetype      row  = qsizetype(id - evicted);
+                const QByteArrayView line = store->line(row);
+                if (filter->accepts(line, store->severity(row))) {
+                    ids.push_back(id);
+                    widest = qMax(widest, line.size());
+                }
+            }
+        }
+        QMetaObject::invokeMethod(this, [this, generation, upTo, widest, ids = std::move(ids)] {
+            finishRefilter(generation, upTo, widest, ids);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void LogView::finishRefilter(quint64 generation, qint64 upTo, qsizetype widest,
+                             const std::vector<qint64>& ids) {
+    if (generation != generation_ || !store_) return;
+
+    const bool   atBottom = isAtBottom();
+    const qint64 top      = lineCount() > 0 ? idAt(verticalScrollBar()->value()) : 0;
+    const qint64 first    = firstId();
+
+    std::deque<qint64> merged;
+    for (qint64 id : ids)
+        if (id >= first) merged.push_back(id);
+    for (qint64 id : matches_)
+        if (id >= upTo) merged.push_back(id);
+    matches_ = std::move(merged);
+    widest_  = qMax(widest_, widest);
+
+    updateScrollBars();
+    verticalScrollBar()->setValue(atBottom ? verticalScrollBar()->maximum() : int(rowOf(top)));
+    viewport()->update();
+}
+
+void LogView::storeCleared() {
+    // Everything in the window gets re-checked by the next storeAppended()
+    cancelRefilter();
+    matches_.clear();
+    ++searchGeneration_;
+    hits_.clear();
+    searching_ = false;
+    first_     = firstId();
+    seen_      = first_;
+    searchUpTo_ = seen_;
+    widest_    = 0;
+    selAnchor_ = selEnd_ = -1;
+    updateScrollBars();
+    viewport()->update();
+}
+
+void LogView::storeAppended() {
+    if (!store_) return;
+    // Nothing to lay out for a view nobody sees; seen_ and first_ stay at
+    // the last sync, so the next call covers everything appended since
+    if (!isShowing()) {
+        stale_ = true;
+        return;
+    }
+    stale_ = false;
+    const qint64 t0       = monotonicNs();
+    const bool   atBottom = isAtBottom();
+    const qint64 evicted  = store_->evicted();
+    const qint64 total    = evicted + store_->size();
+    const qint64 first    = firstId();
+
+    const qsizetype hitCount = qsizetype(hits_.size());
+    while (!hits_.empty() && hits_.front() < first) hits_.pop_front();
+
+    qint64 shifted = first - first_;
+    if (filter_) {
+        shifted = 0;
+        while (!matches_.empty() && matches_.front() < first) {
+            matches_.pop_front();
+            ++shifted;
+        }
+    }
+
+    for (qint64 id = qMax(seen_, first); id < total; ++id) {
+        const qsizetype      row  = qsizetype(id - evicted);
+        const QByteArrayView line     = store_->line(row);
+        const Severity       severity = store_->severity(row);
+        if (filter_) {
+            if (!filter_->accepts(line, severity)) continue;
+            matches_.push_back(id);
+        }
+        if (search_ && search_->accepts(line, severity)) hits_.push_back(id);
+        widest_ = qMax(widest_, line.size());
+    }
+    seen_  = total;
+    first_ = first;
+    finishAppend(atBottom, shifted);
+    if (qsizetype(hits_.size()) != hitCount) reportSearch();
+    renderNs_ += monotonicNs() - t0;
+}
+
+qint64 LogView::firstId() const {
+    if (!store_) return 0;
+    const qint64 total = store_->evicted() + store_->size();
+    return qMax(store_->evicted(), total - window_);
+}
+
+qsizetype LogView::lineCount() const {
+    if (!store_) return 0;
+    if (filter_) return qsizetype(matches_.size());
+    return qsizetype(store_->evicted() + store_->size() - firstId());
+}
+
+qint64 LogView::idAt(qsizetype row) const {
+    return filter_ ? matches_[size_t(row)] : firstId() + row;
+}
+
+qsizetype LogView::rowOf(qint64 id) const {
+    if (!filter_) return qsizetype(id - firstId());
+    return qsizetype(std::lower_bound(matches_.begin(), matches_.end(), id) - matches_.begin());
+}
+
+QByteArrayView LogView::lineAt(qsizetype row) const {
+    return store_->line(qsizetype(idAt(row) - store_->evicted()));
+}
+
+Severity LogView::severityAt(qsizetype row) const {
+    return store_->severity(qsizetype(idAt(row) - store_->evicted()));
+}
+
+quint32 LogView::repeatsAt(qsizetype row) const {
+    return store_->repeats(qsizetype(idAt(row) - store_->evicted()));
+}
+
+void LogView::finishAppend(bool atBottom, qint64 shifted) {
+    auto* sb = verticalScrollBar();
+    const qint64 keep = sb->value() - shifted;
+    updateScrollBars();
+    sb->setValue(atBottom ? sb->maximum() : int(qMax<qint64>(0, keep)));
+    viewport()->update();
+}
+
+bool LogView::isShowing() const {
+    return isVisible() && !window()->isMinimized();
+}
+
+bool LogView::isAtBottom() const {
+    const auto* sb = verticalScrollBar();
+    return sb->value() >= sb->maximum();
+}
+
+qsizetype LogView::rowAt(int y) const {
+    const qsizetype row = verticalScrollBar()->value() + qMax(0, y) / lineHeight_;
+    return qMin(row, lineCount() - 1);
+}
+
+void LogView::updateMetrics() {
+    const QFontMetrics fm(font());
+    lineHeight_ = qMax(1, fm.lineSpacing());
+    charWidth_  = qMax(1, fm.horizontalAdvance(QLatin1Char('M')));
+    ascent_     = fm.ascent();
+    updateScrollBars();
+}
+
+void LogView::updateScrollBars() {
+    const int visibleRows = qMax(1, viewport()->height() / lineHeight_);
+    auto* vsb = verticalScrollBar();
+    vsb->setPageStep(visibleRows);
+    vsb->setSingleStep(1);
+    vsb->setRange(0, int(qMax<qsizetype>(0, lineCount() - visibleRows)));
+
+    // Monospace font, so the longest line in chars bounds the content width
+    auto* hsb = horizontalScrollBar();
+    const int contentWidth = int(qMin<qint64>(qint64(widest_) * charWidth_ + 2 * kMargin,
+                                                std::numeric_limits<int>::max()));
+    hsb->setPageStep(viewport()->width());
+    hsb->setSingleStep(charWidth_ * 4);
+    hsb->setRange(0, qMax(0, contentWidth - viewport()->width()));
+}
+
+void LogView::paintEvent(QPaintEvent* /*event*/) {
+    const qint64 t0 = monotonicNs();
+    QPainter p(viewport());
+    p.fillRect(viewport()->rect(), kBackground);
+    p.setFont(font());
+
+    const qsizetype first = verticalScrollBar()->value();
+    const qsizetype last  = qMin(lineCount(), first + viewport()->height() / lineHeight_ + 1);
+    const int       x     = kMargin - horizontalScrollBar()->value();
+    const qint64    selLo = qMin(selAnchor_, selEnd_);
+    const qint64    selHi = qMax(selAnchor_, selEnd_);
+    JsonProjection::Row json;
+    QList<std::pair<qsizetype, qsizetype>> spans;
+
+    // Marks the search matches in text drawn at column 0, under the text
+    const auto highlight = [&](qint64 stable, int y, const QString& text) {
+        if (!search_ || !isHit(stable)) return;
+        search_->matchSpans(text, spans);
+        const QColor& color = stable == currentHit_ ? kCurrentHit : kSearchHit;
+        for (const auto& [start, length] : spans)
+            p.fillRect(x + int(start) * charWidth_, y, int(length) * charWidth_, lineHeight_, color);
+    };
+
+    for (qsizetype row = first; row < last; ++row) {
+        const int    y      = int(row - first) * lineHeight_;
+        const qint64 stable = idAt(row);
+        if (selAnchor_ >= 0 && stable >= selLo && stable <= selHi)
+            p.fillRect(0, y, viewport()->width(), lineHeight_, kSelection);
+
+        // Decoded only for as long as the row is on screen
+        const QByteArrayView line = lineAt(row);
+        qsizetype            cols = 0;   // where the text ends, in characters
+        p.setPen(colorFor(severityAt(row)));
+        if (projection_ && projection_->project(line, json)) {
+            highlight(stable, y, json.head);
+            p.drawText(x, y + ascent_, json.head);
+            cols = json.head.size();
+            if (!json.extra.isEmpty()) {
+                p.setPen(kExtraFields);
+                p.drawText(x + int(cols + 2) * charWidth_, y + ascent_, json.extra);
+                cols += 2 + json.extra.size();
+            }
+        } else {
+            const QString text = QString::fromUtf8(line.data(), line.size());
+            highlight(stable, y, text);
+            p.drawText(x, y + ascent_, text);
+            cols = text.size();
+        }
+        // Folded repeats, updated in place as more arrive
+        if (const quint32 n = repeatsAt(row); n > 1) {
+            p.setPen(kRepeatCount);
+            p.drawText(x + int(cols + 1) * charWidth_, y + ascent_, QString("×%1").arg(n));
+        }
+    }
+    renderNs_ += monotonicNs() - t0;
+    emit painted();
+}
+
+void LogView::resizeEvent(QResizeEvent* event) {
+    const bool atBottom = isAtBottom();
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+    if (atBottom) verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+}
+
+void LogView::changeEvent(QEvent* event) {
+    if (event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange)
+        updateMetrics();
+    QAbstractScrollArea::changeEvent(event);
+}
+
+void LogView::showEvent(QShowEvent* event) {
+    QAbstractScrollArea::showEvent(event);
+    // Minimizing does not hide child widgets, so follow the window's state too
+    if (window() != watchedWindow_) {
+        if (watchedWindow_) watchedWindow_->removeEventFilter(this);
+        watchedWindow_ = window();
+        watchedWindow_->installEventFilter(this);
+    }
+    if (stale_) storeAppended();
+}
+
+bool LogView::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == watchedWindow_ && event->type() == QEvent::WindowStateChange && stale_)
+        storeAppended();
+    return QAbstractScrollArea::eventFilter(watched, event);
+}
+
+void LogView::keyPressEvent(QKeyEvent* event) {
+    if (event->matches(QKeySequence::Copy)) {
+        copySelection();
+    } else if (event->matches(QKeySequence::SelectAll)) {
+        selectAll();
+    } else if (event->key() == Qt::Key_End) {
+        verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+    } else if (event->key() == Qt::Key_Home) {
+        verticalScrollBar()->setValue(0);
+    } else {
+        QAbstractScrollArea::keyPressEvent(event);
+    }
+}
+
+void LogView::mousePressEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton || lineCount() == 0) {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+    const qint64 stable = idAt(rowAt(int(event->position().y())));
+    if (event->modifiers() & Qt::ShiftModifier && selAnchor_ >= 0) {
+        selEnd_ = stable;
+    } else {
+        selAnchor_ = selEnd_ = stable;
+    }
+    viewport()->update();
+}
+
+void LogView::mouseMoveEvent(QMouseEvent* event) {
+    if (!(event->buttons() & Qt::LeftButton) || selAnchor_ < 0 || lineCount() == 0) return;
+
+    // Dragging past the edges scrolls by a row per event
+    const int y = int(event->position().y());
+    auto* sb = verticalScrollBar();
+    if (y < 0)                        sb->setValue(sb->value() - 1);
+    else if (y > viewport()->height()) sb->setValue(sb->value() + 1);
+
+    selEnd_ = idAt(rowAt(qMin(y, viewport()->height() - 1)));
+    viewport()->update();
+}
+
+void LogView::contextMenuEvent(QContextMenuEvent* event) {
+    QMenu menu(this);
+    QAction* copy = menu.addAction("Copy", this, &LogView::copySelection);
+    copy->setEnabled(selAnchor_ >= 0);
+    menu.addAction("Select All", this, &LogView::selectAll);
+    menu.addSeparator();
+    menu.addAction(filter_ ? "Copy Shown Lines" : "Copy All Lines", this, &LogView::copyShown)
+        ->setEnabled(lineCount() > 0);
+    menu.addAction("Save Buffer…", this, [this] {
+        const QString name = QDateTime::currentDateTime().toString("'log-'yyyyMMdd-HHmmss'.log'");
+        const QString path = QFileDialog::getSaveFileName(
+            this, "Save Buffer", QDir::home().filePath(name), "Log files (*.log *.txt);;All files (*)");
+        if (!path.isEmpty()) saveBuffer(path);
+    })->setEnabled(store_ && store_->size() > 0);
+    menu.exec(event->globalPos());
+}
+
+void LogView::copySelection() const {
+    if (selAnchor_ < 0) return;
+    // Clamp to what is still shown; selected rows may have been evicted
+    const qsizetype lo = qMax<qsizetype>(0, rowOf(qMin(selAnchor_, selEnd_)));
+    const qsizetype hi = qMin(lineCount() - 1, rowOf(qMax(selAnchor_, selEnd_) + 1) - 1);
+
+    QByteArray out;
+    for (qsizetype row = lo; row <= hi; ++row) {
+        if (row > lo) out.append('\n');
+        out.append(lineAt(row));
+        if (const quint32 n = repeatsAt(row); n > 1) out.append(" ×" + QByteArray::number(n));
+    }
+    QApplication::clipboard()->setText(QString::fromUtf8(out));
+}
+
+void LogView::selectAll() {
+    if (lineCount() == 0) return;
+    selAnchor_ = idAt(0);
+    selEnd_    = idAt(lineCount() - 1);
+    viewport()->update();
+}
@@ -0,0 +1,159 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "JsonLine.h"
+#include "LineFilter.h"
+#include "LineStore.h"
+
+#include <QAbstractScrollArea>
+#include <QPointer>
+#include <QThreadPool>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Virtualized log viewport over a LineStore, showing its newest maxLines
+// rows. The store may be shared with other views. Only the rows inside the
+// viewport are decoded and painted, so syncing after an append stays O(1)
+// regardless of how many lines are retained. With a filter set, the view
+// keeps the stable ids of accepted lines; new lines are checked on arrival
+// and re-filtering the retained lines runs on a worker thread. While the
+// view is hidden or its window minimized, appends only mark it stale and it
+// catches up in one pass when shown again. With a JSON projection set, JSON
+// object rows are parsed as they are painted and drawn as columns. A search
+// runs over the shown lines on the same worker thread as re-filtering and
+// keeps the stable ids of its hits; only the rows on screen are highlighted.
+class LogView : public QAbstractScrollArea {
+    Q_OBJECT
+
+public:
+    explicit LogView(QWidget* parent = nullptr);
+    ~LogView() override;
+
+    // The store must outlive the view or be detached with setStore(nullptr).
+    void setStore(const LineStore* store);
+    void setMaxLines(int maxLines);
+    // nullptr or a trivial filter shows every line.
+    void setFilter(std::shared_ptr<const LineFilter> filter);
+    // nullptr shows JSON lines as they are. Copying always copies the raw lines.
+    void setProjection(std::shared_ptr<const JsonProjection> projection);
+
+    // Finds lines the query accepts among those shown; nullptr ends the search.
+    void setSearch(std::shared_ptr<const LineFilter> query);
+    // Scrolls to and selects the next or previous hit, wrapping around.
+    void findNext(bool backward = false);
+
+    // Write the retained lines, or only those the filter shows, on the worker
+    // thread straight from the store's UTF-8; exported() reports the result.
+    void saveBuffer(const QString& path);
+    void copyShown();
+
+    // Call after the store was appended to or cleared.
+    void storeAppended();
+    void storeCleared();
+
+    qsizetype lineCount() const;
+    // Time spent syncing after appends and painting, cumulative.
+    qint64    renderNs() const { return renderNs_; }
+
+signals:
+    void painted();
+    // `current` is the 1-based selected hit or 0; `done` once the scan finished.
+    void searchProgress(qsizetype current, qsizetype total, bool done);
+    // A finished save or copy, as a short message for display.
+    void exported(const QString& message, bool ok);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void changeEvent(QEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void contextMenuEvent(QContextMenuEvent* event) override;
+
+private:
+    // Stable id (store row + evicted count) of the window's oldest line
+    qint64         firstId() const;
+    // Stable id shown in a view row, and the first row showing `id` or later
+    qint64         idAt(qsizetype row) const;
+    qsizetype      rowOf(qint64 id) const;
+    QByteArrayView lineAt(qsizetype row) const;
+    Severity       severityAt(qsizetype row) const;
+    quint32        repeatsAt(qsizetype row) const;
+    // Keeps the view pinned to the bottom or, when scrolled up, on the
+    // same lines after the window moved forward by `shifted` rows.
+    void finishAppend(bool atBottom, qint64 shifted);
+
+    void startRefilter();
+    void cancelRefilter() { ++generation_; }
+    // Swaps in the matches for ids below `upTo`; later ones were already
+    // checked against the current filter as they arrived.
+    void finishRefilter(quint64 generation, qint64 upTo, qsizetype widest,
+                        const std::vector<qint64>& ids);
+
+    void startSearch();
+    // Adds the hits a search job found in one chunk, all below `upTo`.
+    void addSearchHits(quint64 generation, qint64 upTo, const std::vector<qint64>& ids,
+                       bool done);
+    bool isHit(qint64 id) const;
+    void reportSearch();
+
+    // Visible and not in a minimized window
+    bool      isShowing() const;
+    bool      isAtBottom() const;
+    qsizetype rowAt(int y) const;
+    void      updateMetrics();
+    void      updateScrollBars();
+    void      copySelection() const;
+    void      selectAll();
+
+    const LineStore*      store_    = nullptr;
+    qsizetype             window_   = 500;   // rows shown, newest first
+    qint64                first_    = 0;     // firstId() at the last sync
+    qint64                seen_     = 0;     // store total at the last sync
+    qsizetype             widest_   = 0;     // longest line seen, in bytes
+
+    int                   lineHeight_ = 14;
+    int                   charWidth_  = 7;
+    int                   ascent_     = 11;
+
+    qint64                selAnchor_ = -1;   // stable row numbers, -1 = no selection
+    qint64                selEnd_    = -1;
+
+    bool                  stale_    = false;   // appends skipped while not showing
+    qint64                renderNs_ = 0;
+    QPointer<QWidget>     watchedWindow_;    // for WindowStateChange
+
+    std::shared_ptr<const LineFilter> filter_;   // null when every line is shown
+    std::shared_ptr<const JsonProjection> projection_;
+    std::deque<qint64>    matches_;          // stable ids of accepted lines
+    std::atomic<quint64>  generation_ {0};   // bumped to cancel refilter jobs
+
+    std::shared_ptr<const LineFilter> search_;
+    std::deque<qint64>    hits_;             // stable ids, ascending
+    qint64                currentHit_ = -1;  // stable id
+    qint64                searchUpTo_ = 0;   // the job covers ids below this
+    bool                  searching_  = false;
+    std::atomic<quint64>  searchGeneration_ {0};
+    QThreadPool           pool_;
+};
@@ -0,0 +1,291 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "RemoteConnection.h"
+
+#include "IngestMetrics.h"
+
+#include <QTimer>
+
+#include <zlib.h>
+
+namespace {
+
+constexpr int kMaxRetryMs = 30'000;
+// What a remote shell exits with when the command does not exist
+constexpr int kCommandNotFound = 127;
+
+QHash<QString, std::weak_ptr<RemoteConnection>>& registry() {
+    static QHash<QString, std::weak_ptr<RemoteConnection>> connections;
+    return connections;
+}
+
+// For the remote shell, which sees the command line ssh sends as one string
+QString shellQuote(const QString& arg) {
+    QString quoted = arg;
+    quoted.replace(QLatin1Char('\''), QStringLiteral("'\\''"));
+    return QLatin1Char('\'') + quoted + QLatin1Char('\'');
+}
+
+}  // namespace
+
+std::shared_ptr<RemoteConnection> RemoteConnection::acquire(const QString& host,
+                                                            const QString& agent) {
+    const QString key = host + QLatin1Char('\n') + agent;
+    std::weak_ptr<RemoteConnection>& slot = registry()[key];
+    if (auto connection = slot.lock()) return connection;
+
+    std::shared_ptr<RemoteConnection> connection(new RemoteConnection(host, agent, key));
+    slot = connection;
+    return connection;
+}
+
+RemoteConnection::RemoteConnection(const QString& host, const QString& agent, const QString& key)
+    : host_(host), agent_(agent.isEmpty() ? QStringLiteral("logtail-agent") : agent), key_(key) {
+    qRegisterMetaType<LineBatch>();
+    retryTimer_ = new QTimer(this);
+    retryTimer_->setSingleShot(true);
+    connect(retryTimer_, &QTimer::timeout, this, &RemoteConnection::connectToHost);
+}
+
+RemoteConnection::~RemoteConnection() {
+    if (process_) {
+        disconnect(process_, nullptr, this, nullptr);
+        process_->kill();
+        process_->waitForFinished(500);
+    }
+    auto it = registry().find(key_);
+    if (it != registry().end() && it->expired())
+        registry().erase(it);
+}
+
+// ── Streams ───────────────────────────────────────────────────────────────────
+
+int RemoteConnection::subscribe(const QString& path, int maxLines) {
+    // Ids go on the wire as 16 bits; after wrapping, skip ones still in use
+    // (and 0). At most 65535 streams can be live at once.
+    quint16 id = nextId_++;
+    while (id == 0 || streams_.contains(id)) id = nextId_++;
+    Stream& stream  = streams_[id];
+    stream.path     = path;
+    stream.maxLines = maxLines;
+
+    if (!process_) {
+        connectToHost();
+    } else if (!agentMissing_) {
+        sendTail(id, stream);
+    } else {
+        // tail -F takes its paths up front; every stream reseeds
+        process_->kill();
+    }
+    return id;
+}
+
+void RemoteConnection::unsubscribe(int stream) {
+    if (!streams_.remove(stream)) return;
+    // The fallback's tail keeps running; output for unknown paths is ignored
+    if (process_ && !agentMissing_ && process_->state() == QProcess::Running)
+        process_->write(QByteArray("drop ") + QByteArray::number(stream) + '\n');
+}
+
+void RemoteConnection::sendTail(int id, const Stream& stream) {
+    streams_[id].nextSeq = 0;
+    const QByteArray command = QByteArray("tail ") + QByteArray::number(id) + ' ' +
+                               QByteArray::number(stream.maxLines) + ' ' +
+                               QByteArray::number(stream.inode) + ' ' +
+                               QByteArray::number(stream.offset) + ' ' +
+                               stream.path.toUtf8() + '\n';
+    process_->write(command);
+}
+
+// ── Connection ────────────────────────────────────────────────────────────────
+
+void RemoteConnection::connectToHost() {
+    if (process_) {
+        disconnect(process_, nullptr, this, nullptr);
+        process_->deleteLater();
+        process_ = nullptr;
+    }
+    buffer_.clear();
+    tailStream_ = -1;
+
+    // BatchMode: never block on a password prompt nobody can answer
+    QStringList args = {"-T", "-o", "BatchMode=yes", "-o", "ServerAliveInterval=15",
+                        "-o", "ServerAliveCountMax=3", host_, "--"};
+    if (!agentMissing_) {
+        args << agent_;
+    } else {
+        int maxLines = 0;
+        QStringList paths;
+        for (const Stream& s : std::as_const(streams_)) {
+            maxLines = qMax(maxLines, s.maxLines);
+            paths << shellQuote(s.path);
+        }
+        if (paths.isEmpty()) return;
+        args << "tail" << "-v" << "-n" << QString::number(maxLines) << "-F" << "--" << paths;
+    }
+
+    process_ = new QProcess(this);
+    connect(process_, &QProcess::readyReadStandardOutput, this, &RemoteConnection::onStdout);
+    connect(process_, &QProcess::readyReadStandardError,  this, &RemoteConnection::onStderr);
+    connect(process_, &QProcess::finished, this, &RemoteConnection::onFinished);
+    connect(process_, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart)
+            emit message(-1, "ssh: failed to start — is OpenSSH installed?", Severity::Error);
+    });
+    process_->start("ssh", args);
+
+    if (!agentMissing_) {
+        // Resumes where each stream left off, or seeds if it never started
+        for (auto it = streams_.cbegin(); it != streams_.cend(); ++it)
+            sendTail(it.key(), it.value());
+    } else {
+        for (auto it = streams_.cbegin(); it != streams_.cend(); ++it)
+            emit reset(it.key());
+    }
+}
+
+void RemoteConnection::onFinished(int exitCode, QProcess::ExitStatus status) {
+    if (status == QProcess::NormalExit && exitCode == kCommandNotFound && !agentMissing_) {
+        agentMissing_ = true;
+        emit message(-1, QString("%1: %2 not found, falling back to tail -F").arg(host_, agent_),
+                     Severity::Warning);
+        connectToHost();
+        return;
+    }
+    if (streams_.isEmpty()) return;
+    // Killed by subscribe() in fallback mode: reconnect right away
+    const int delay = status == QProcess::CrashExit && agentMissing_ ? 0 : retryMs_;
+    if (delay > 0) {
+        emit message(-1, QString("%1: connection lost, retrying in %2 s")
+                             .arg(host_).arg(delay / 1000), Severity::Warning);
+        retryMs_ = qMin(retryMs_ * 2, kMaxRetryMs);
+    }
+    retryTimer_->start(delay);
+}
+
+void RemoteConnection::onStderr() {
+    const QByteArray text = process_->readAllStandardError().trimmed();
+    for (const QByteArray& line : text.split('\n')) {
+        if (!line.trimmed().isEmpty())
+            emit message(-1, host_ + ": " + QString::fromUtf8(line.trimmed()), Severity::Warning);
+    }
+}
+
+void RemoteConnection::onStdout() {
+    buffer_.append(process_->readAllStandardOutput());
+    retryMs_ = 1000;   // the connection works
+    if (agentMissing_) readTailOutput();
+    else               readFrames();
+}
+
+// ── Agent frames ──────────────────────────────────────────────────────────────
+
+void RemoteConnection::readFrames() {
+    qsizetype pos = 0;
+    while (buffer_.size() - pos >= qsizetype(remote::kHeaderSize)) {
+        remote::FrameHeader header;
+        if (!remote::decodeHeader(reinterpret_cast<const uchar*>(buffer_.constData() + pos),
+                                  header)) {
+            emit message(-1, host_ + ": garbled data from the agent, reconnecting",
+                         Severity::Error);
+            buffer_.clear();
+            process_->kill();
+            return;
+        }
+        const qsizetype size = qsizetype(remote::kHeaderSize) + header.payloadSize;
+        if (buffer_.size() - pos < size) break;
+        handleFrame(header, QByteArrayView(buffer_).sliced(pos + qsizetype(remote::kHeaderSize),
+                                                         header.payloadSize));
+        pos += size;
+    }
+    buffer_.remove(0, pos);
+}
+
+void RemoteConnection::handleFrame(const remote::FrameHeader& header, QByteArrayView payload) {
+    const auto it = streams_.find(header.stream);
+    if (it == streams_.end()) return;   // dropped since
+    Stream& stream = it.value();
+
+    QByteArray inflated;
+    if (header.flags & remote::kFlagCompressed) {
+        inflated.resize(header.rawSize);
+        uLongf size = header.rawSize;
+        if (uncompress(reinterpret_cast<Bytef*>(inflated.data()), &size,
+                       reinterpret_cast<const Bytef*>(payload.data()), uLong(payload.size()))
+                != Z_OK || size != header.rawSize) {
+            emit message(header.stream, "Corrupt frame from the agent", Severity::Error);
+            return;
+        }
+        payload = inflated;
+    }
+    if (header.flags & remote::kFlagError) {
+        emit message(header.stream, QString::fromUtf8(payload), Severity::Error);
+        return;
+    }
+    if (header.flags & remote::kFlagSeed) {
+        stream.nextSeq = header.seq;
+        emit reset(header.stream);
+    }
+    if (header.seq != stream.nextSeq)
+        emit message(header.stream, "Frames out of order; lines may be missing", Severity::Warning);
+    if (header.flags & remote::kFlagRotated)
+        emit message(header.stream, "─── log rotated ───", Severity::Debug);
+
+    stream.nextSeq = header.seq + 1;
+    stream.inode   = header.inode;
+    stream.offset  = header.offset;
+    deliver(header.stream, payload);
+}
+
+// ── tail -F fallback ──────────────────────────────────────────────────────────
+
+void RemoteConnection::readTailOutput() {
+    const qsizetype end = buffer_.lastIndexOf('\n') + 1;
+    if (end == 0) return;
+
+    QByteArrayView text(buffer_.constData(), end);
+    qsizetype      from = 0;   // start of the lines for tailStream_
+    for (qsizetype pos = 0; pos < end; ) {
+        const qsizetype nl   = text.indexOf('\n', pos);
+        const QByteArrayView line = text.sliced(pos, nl - pos);
+        if (line.startsWith("==> ") && line.endsWith(" <==")) {
+            deliver(tailStream_, text.sliced(from, pos - from));
+            const QString path = QString::fromUtf8(line.sliced(4, line.size() - 8));
+            tailStream_ = -1;
+            for (auto it = streams_.cbegin(); it != streams_.cend(); ++it) {
+                if (it->path == path) tailStream_ = it.key();
+            }
+            from = nl + 1;
+        }
+        pos = nl + 1;
+    }
+    deliver(tailStream_, text.sliced(from));
+    buffer_.remove(0, end);
+}
+
+void RemoteConnection::deliver(int id, QByteArrayView text) {
+    if (id < 0 || text.isEmpty() || !streams_.contains(id)) return;
+
+    LineBatch lines;
+    records_.clear();
+    scanLines(text.data(), text.size(), records_);
+    for (const LineRecord& r : records_) {
+        if (r.length > 0) lines.append(text.sliced(r.offset, r.length), r.severity);
+    }
+    lines.noticedNs = monotonicNs();
+    if (!lines.isEmpty()) emit linesReady(id, lines);
+}
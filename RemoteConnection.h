@@ -0,0 +1,95 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "LineBatch.h"
+#include "RemoteProtocol.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+class QTimer;
+
+// One ssh connection per remote host, shared by every source that follows
+// a file there. Runs logtail-agent on the host and multiplexes all streams
+// over its stdio as batched, compressed frames; after a dropped connection
+// it reconnects with backoff and each stream resumes from the last offset
+// it received instead of reseeding. If the agent is not installed the
+// connection falls back to one `tail -F` over every path, which reseeds on
+// reconnect. Lives on the GUI thread, like the journalctl fallback.
+class RemoteConnection : public QObject {
+    Q_OBJECT
+
+public:
+    // `host` is anything ssh accepts as a destination; `agent` the command
+    // that starts logtail-agent there.
+    static std::shared_ptr<RemoteConnection> acquire(const QString& host, const QString& agent);
+
+    ~RemoteConnection() override;
+
+    // Starts following `path`; returns the stream id used by the signals.
+    int  subscribe(const QString& path, int maxLines);
+    void unsubscribe(int stream);
+
+signals:
+    void linesReady(int stream, const LineBatch& lines);
+    // The stream starts over with fresh seed lines; drop what it delivered.
+    void reset(int stream);
+    // Errors and connection status; stream -1 concerns every stream.
+    void message(int stream, const QString& text, Severity severity);
+
+private:
+    RemoteConnection(const QString& host, const QString& agent, const QString& key);
+
+    struct Stream {
+        QString  path;
+        int      maxLines = 500;
+        quint64  inode    = 0;   // where the last frame ended, for resuming
+        quint64  offset   = 0;
+        quint32  nextSeq  = 0;
+    };
+
+    void connectToHost();
+    void onStdout();
+    void onStderr();
+    void onFinished(int exitCode, QProcess::ExitStatus status);
+    void sendTail(int id, const Stream& stream);
+    void readFrames();
+    void handleFrame(const remote::FrameHeader& header, QByteArrayView payload);
+    // Fallback mode: `tail -v -F` output, split by its "==> path <==" headers
+    void readTailOutput();
+    void deliver(int id, QByteArrayView text);
+
+    QString               host_;
+    QString               agent_;
+    QString               key_;       // registry key
+    QProcess*             process_   = nullptr;
+    QTimer*               retryTimer_ = nullptr;
+    int                   retryMs_   = 1000;
+    bool                  agentMissing_ = false;
+    QByteArray            buffer_;    // unparsed stdout
+    QHash<int, Stream>    streams_;
+    quint16               nextId_    = 1;   // wire stream ids are 16 bits
+    int                   tailStream_ = -1;   // fallback: stream of the current section
+    std::vector<LineRecord> records_;
+};
@@ -0,0 +1,110 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// Wire format between the widget and logtail-agent. Kept free of Qt so the
+// agent builds with nothing but a C++ compiler and zlib.
+//
+// The widget writes one command per line to the agent's stdin:
+//
+//   tail <stream> <maxLines> <inode> <offset> <path>
+//       Follow <path> as <stream>. With a known inode and offset the agent
+//       resumes right after them if the file is still the same one and at
+//       least that long; otherwise it seeds with the last maxLines lines.
+//   drop <stream>
+//       Stop following a stream.
+//
+// The agent answers with frames: a fixed little-endian header followed by
+// `payloadSize` bytes of newline-terminated lines, zlib-deflated when
+// kFlagCompressed is set. `offset` and `inode` locate the end of the
+// batch in the remote file and are what a reconnect resumes from.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace remote {
+
+constexpr std::uint32_t kMagic      = 0x3146544c;   // "LTF1"
+constexpr std::size_t   kHeaderSize = 40;
+// Larger batches are split; also bounds what a corrupt header can make us allocate
+constexpr std::uint32_t kMaxPayload = 4 * 1024 * 1024;
+// Longest line the agent sends, note of what was cut included; the same
+// limit as the viewer's kMaxLineBytes, so it passes such lines through
+constexpr std::size_t   kMaxLine    = 64 * 1024;
+
+enum Flags : std::uint16_t {
+    kFlagCompressed = 1 << 0,
+    kFlagSeed       = 1 << 1,   // starts over with fresh seed lines, not a resume
+    kFlagRotated    = 1 << 2,   // the path now names another file
+    kFlagError      = 1 << 3,   // payload is an error message
+};
+
+struct FrameHeader {
+    std::uint32_t magic       = kMagic;
+    std::uint16_t stream      = 0;
+    std::uint16_t flags       = 0;
+    std::uint32_t seq         = 0;   // per stream, from 0 after every seed
+    std::uint32_t payloadSize = 0;
+    std::uint32_t rawSize     = 0;   // payload size before compression
+    std::uint32_t reserved    = 0;
+    std::uint64_t offset      = 0;
+    std::uint64_t inode       = 0;
+};
+
+namespace detail {
+
+template <typename T>
+void put(unsigned char*& p, T v) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) *p++ = static_cast<unsigned char>(v >> (8 * i));
+}
+
+template <typename T>
+T get(const unsigned char*& p) {
+    T v = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) v |= static_cast<T>(T(*p++) << (8 * i));
+    return v;
+}
+
+}  // namespace detail
+
+inline void encodeHeader(const FrameHeader& h, unsigned char* out) {
+    detail::put(out, h.magic);
+    detail::put(out, h.stream);
+    detail::put(out, h.flags);
+    detail::put(out, h.seq);
+    detail::put(out, h.payloadSize);
+    detail::put(out, h.rawSize);
+    detail::put(out, h.reserved);
+    detail::put(out, h.offset);
+    detail::put(out, h.inode);
+}
+
+// False if the bytes are not a plausible header.
+inline bool decodeHeader(const unsigned char* in, FrameHeader& h) {
+    h.magic       = detail::get<std::uint32_t>(in);
+    h.stream      = detail::get<std::uint16_t>(in);
+    h.flags       = detail::get<std::uint16_t>(in);
+    h.seq         = detail::get<std::uint32_t>(in);
+    h.payloadSize = detail::get<std::uint32_t>(in);
+    h.rawSize     = detail::get<std::uint32_t>(in);
+    h.reserved    = detail::get<std::uint32_t>(in);
+    h.offset      = detail::get<std::uint64_t>(in);
+    h.inode       = detail::get<std::uint64_t>(in);
+    return h.magic == kMagic && h.payloadSize <= kMaxPayload && h.rawSize <= kMaxPayload;
+}
+
+}  // namespace remote
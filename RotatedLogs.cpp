@@ -0,0 +1,219 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "RotatedLogs.h"
+
+#include "LineFilter.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+#include <zlib.h>
+#ifdef LOGTAIL_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr qsizetype kChunkSize = 64 * 1024;
+
+bool isGzip(const QByteArray& head) {
+    return head.size() >= 2 && uchar(head[0]) == 0x1f && uchar(head[1]) == 0x8b;
+}
+
+bool isZstd(const QByteArray& head) {
+    return head.size() >= 4 && std::memcmp(head.constData(), "\x28\xb5\x2f\xfd", 4) == 0;
+}
+
+// Collects the last lines of a byte stream fed in arbitrary pieces
+class TailCollector {
+public:
+    TailCollector(int maxLines, const LineFilter* filter)
+        : maxLines_(qMax(1, maxLines)), filter_(filter) {}
+
+    void feed(const char* data, qsizetype len) {
+        partial_.append(data, len);
+        records_.clear();
+        const qsizetype tail = scanLines(partial_.constData(), partial_.size(), records_);
+        for (const LineRecord& r : records_) {
+            const QByteArrayView line(partial_.constData() + r.offset, r.length);
+            const qint64 cut = std::exchange(cut_, 0);   // only the first line was carried
+            if (r.length == 0 || (filter_ && !filter_->accepts(line, r.severity))) continue;
+            lines_.append(line, r.severity, cut);
+        }
+        partial_.remove(0, tail);
+        // Keep just enough of an unterminated line for it to be cut when it ends
+        if (partial_.size() > kMaxLineBytes + 1) {
+            cut_ += partial_.size() - (kMaxLineBytes + 1);
+            partial_.truncate(kMaxLineBytes + 1);
+        }
+        // Everything older than the last maxLines is dropped as we go
+        if (lines_.size() > 2 * maxLines_) lines_.keepLast(maxLines_);
+    }
+
+    LineBatch finish() {
+        if (!partial_.isEmpty()) feed("\n", 1);
+        lines_.keepLast(maxLines_);
+        return std::move(lines_);
+    }
+
+private:
+    int                     maxLines_;
+    const LineFilter*       filter_;
+    QByteArray              partial_;
+    qint64                  cut_ = 0;   // bytes of partial_'s line dropped
+    std::vector<LineRecord> records_;
+    LineBatch               lines_;
+};
+
+using Sink = std::function<void(const char*, qsizetype)>;
+
+bool inflateGzip(QFile& f, const Sink& sink) {
+    z_stream zs {};
+    // 16 + MAX_WBITS: expect a gzip wrapper
+    if (inflateInit2(&zs, 16 + MAX_WBITS) != Z_OK) return false;
+
+    QByteArray in(kChunkSize, Qt::Uninitialized);
+    QByteArray out(kChunkSize, Qt::Uninitialized);
+    bool       ended = false;   // at a member boundary
+    bool       ok    = true;
+    qint64     n;
+    while (ok && (n = f.read(in.data(), in.size())) > 0) {
+        zs.next_in  = reinterpret_cast<Bytef*>(in.data());
+        zs.avail_in = uInt(n);
+        // Also loops while the output buffer came back full: inflate may
+        // hold more output even with no input left
+        do {
+            zs.next_out  = reinterpret_cast<Bytef*>(out.data());
+            zs.avail_out = uInt(out.size());
+            const int ret = inflate(&zs, Z_NO_FLUSH);
+            if (ret == Z_BUF_ERROR) break;   // needs more input
+            if (ret != Z_OK && ret != Z_STREAM_END) {
+                // Trailing garbage after a complete member is not an error
+                ok = ended;
+                break;
+            }
+            sink(out.constData(), out.size() - qsizetype(zs.avail_out));
+            ended = ret == Z_STREAM_END;
+            // gzip allows several members back to back
+            if (ended && inflateReset(&zs) != Z_OK) {
+                ok = false;
+                break;
+            }
+        } while (zs.avail_in > 0 || zs.avail_out == 0);
+        if (!ok || (ended && zs.avail_in > 0)) break;
+    }
+    inflateEnd(&zs);
+    return ok;
+}
+
+#ifdef LOGTAIL_HAVE_ZSTD
+bool decompressZstd(QFile& f, const Sink& sink) {
+    ZSTD_DStream* zs = ZSTD_createDStream();
+    if (!zs) return false;
+
+    QByteArray in(qsizetype(ZSTD_DStreamInSize()), Qt::Uninitialized);
+    QByteArray out(qsizetype(ZSTD_DStreamOutSize()), Qt::Uninitialized);
+    bool       ok = true;
+    qint64     n;
+    while (ok && (n = f.read(in.data(), in.size())) > 0) {
+        ZSTD_inBuffer input {in.constData(), size_t(n), 0};
+        // As with gzip, a full output buffer means the decoder may hold more
+        // even with all input consumed, so keep going until it comes back
+        // short; that also flushes everything once the last chunk is in
+        bool full = false;
+        do {
+            ZSTD_outBuffer output {out.data(), size_t(out.size()), 0};
+            if (ZSTD_isError(ZSTD_decompressStream(zs, &output, &input))) {
+                ok = false;
+                break;
+            }
+            sink(out.constData(), qsizetype(output.pos));
+            full = output.pos == output.size;
+        } while (input.pos < input.size || full);
+    }
+    ZSTD_freeDStream(zs);
+    return ok;
+}
+#endif
+
+}  // namespace
+
+QStringList rotatedSegments(const QString& path) {
+    static const char* const kSuffixes[] = {"", ".gz", ".zst"};
+    QStringList segments;
+    for (int n = 1; ; ++n) {
+        const QString base  = path + "." + QString::number(n);
+        QString       found;
+        for (const char* suffix : kSuffixes) {
+            if (QFileInfo::exists(base + suffix)) {
+                found = base + suffix;
+                break;
+            }
+        }
+        if (found.isEmpty()) break;
+        segments.append(found);
+    }
+    return segments;
+}
+
+bool readSegmentTail(const QString& segment, int maxLines, const LineFilter* filter,
+                     LineBatch& out) {
+    QFile f(segment);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+
+    TailCollector collect(maxLines, filter);
+    const Sink    sink = [&](const char* data, qsizetype len) { collect.feed(data, len); };
+    const QByteArray head = f.peek(4);
+
+    bool ok = true;
+    if (isGzip(head)) {
+        ok = inflateGzip(f, sink);
+    } else if (isZstd(head)) {
+#ifdef LOGTAIL_HAVE_ZSTD
+        ok = decompressZstd(f, sink);
+#else
+        return false;
+#endif
+    } else {
+        // Uncompressed, e.g. <path>.1 right after rotation: count lines
+        // backwards from the end and read only the tail that will be kept
+        QByteArray buf(kChunkSize, Qt::Uninitialized);
+        BackScan   st;
+        qint64     start = 0;
+        for (qint64 pos = f.size(); pos > 0; ) {
+            const qint64 len = qMin<qint64>(kChunkSize, pos);
+            pos -= len;
+            if (!f.seek(pos) || f.read(buf.data(), len) != len) return false;
+            if (const qint64 i = scanBack(buf.constData(), len, maxLines, st); i >= 0) {
+                start = pos + i;
+                break;
+            }
+        }
+        if (!f.seek(start)) return false;
+        qint64 n;
+        while ((n = f.read(buf.data(), buf.size())) > 0) sink(buf.constData(), n);
+        ok = n == 0;
+    }
+    if (!ok) return false;
+    out.append(collect.finish());
+    return true;
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "LineBatch.h"
+
+#include <QString>
+#include <QStringList>
+
+class LineFilter;
+
+// Rotated predecessors of a log file, newest first, as logrotate names
+// them: <path>.1, <path>.2.gz, <path>.3.zst and so on, compressed or not.
+// Stops at the first missing number.
+QStringList rotatedSegments(const QString& path);
+
+// Streams a rotated segment and appends its last `maxLines` lines to `out`,
+// decompressing gzip and, when built with libzstd, zstd on the fly (detected
+// by magic bytes, not by name). An uncompressed segment is scanned backwards
+// from its end instead, so only the tail that is kept gets read. Lines the
+// filter rejects are skipped. Returns false if the segment could not be read or decompressed.
+bool readSegmentTail(const QString& segment, int maxLines, const LineFilter* filter,
+                     LineBatch& out);
@@ -0,0 +1,495 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "ScrollbackView.h"
+
+#include "Timestamp.h"
+
+#include <QCoreApplication>
+#include <QFontMetrics>
+#include <QKeyEvent>
+#include <QLocale>
+#include <QPainter>
+#include <QScrollBar>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const QColor kBackground("#0d1117");
+const QColor kSearchHit(0xf1, 0xfa, 0x8c, 60);
+const QColor kCurrentHit(0xff, 0xb8, 0x6c, 110);
+constexpr int       kMargin        = 4;
+constexpr qint64    kReadSize      = 64 * 1024;
+constexpr int       kRefreshMs     = 2000;
+// A search reads this much per chunk and posts the hits found in it
+constexpr qint64    kScanSize      = 1024 * 1024;
+// Screens kept in memory above and below the one shown
+constexpr qint64    kSpareScreens  = 2;
+
+// Reads up to `count` lines starting at row `first`, blank lines included
+LineBatch readLines(QFile& file, const LineIndex& index, qint64 first, qint64 count) {
+    LineBatch lines;
+    if (first < 0 || first >= index.lineCount()) return lines;
+    count = qMin(count, index.lineCount() - first);
+
+    // Start at the block's first line and skip to `first`
+    qint64       skip = first - index.blockStart(first);
+    qint64       pos  = index.blockOffset(first);
+    const qint64 end  = index.indexedSize();
+    QByteArray   chunk;
+    QByteArray   carry;   // start of a line continued in the next chunk
+
+    const auto finish = [&](QByteArrayView line) {
+        const LineRecord r = makeRecord(line.data(), 0, line.size());
+        lines.append(line.sliced(r.offset, r.length), r.severity);
+        --count;
+    };
+
+    while (count > 0 && pos < end) {
+        const qint64 len = qMin(kReadSize, end - pos);
+        chunk.resize(len);
+        if (!file.seek(pos) || file.read(chunk.data(), len) != len) break;
+        pos += len;
+
+        const char* p = chunk.constData();
+        qsizetype   i = 0;
+        while (count > 0 && i < len) {
+            const void* nl = std::memchr(p + i, '\n', size_t(len - i));
+            const qsizetype e = nl ? static_cast<const char*>(nl) - p : len;
+            if (skip == 0 && carry.size() < kMaxLineBytes)
+                carry.append(p + i, qMin<qsizetype>(e - i, kMaxLineBytes - carry.size()));
+            if (!nl) break;
+            if (skip > 0) --skip;
+            else          finish(carry);
+            carry.clear();
+            i = e + 1;
+        }
+    }
+    return lines;
+}
+
+}  // namespace
+
+ScrollbackView::ScrollbackView(QWidget* parent) : QAbstractScrollArea(parent) {
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setFocusPolicy(Qt::StrongFocus);
+    pool_.setMaxThreadCount(1);
+
+    readPool_.setMaxThreadCount(1);
+
+    refreshTimer_ = new QTimer(this);
+    refreshTimer_->setInterval(kRefreshMs);
+    connect(refreshTimer_, &QTimer::timeout, this, &ScrollbackView::startIndexing);
+    updateMetrics();
+}
+
+ScrollbackView::~ScrollbackView() { close(); }
+
+void ScrollbackView::open(const QString& path) {
+    close();
+    path_ = path;
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::ReadOnly)) {
+        emit status(QString("cannot open %1").arg(path));
+        return;
+    }
+
+    // A cached index is shown as is; the first update corrects it if the
+    // file was replaced in the meantime
+    auto cached = std::make_shared<LineIndex>();
+    if (cached->load(LineIndex::cachePath(path))) index_ = std::move(cached);
+    updateScrollBars();
+    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+    startIndexing();
+    if (isVisible()) refreshTimer_->start();
+}
+
+void ScrollbackView::close() {
+    refreshTimer_->stop();
+    cancel_ = true;
+    pool_.waitForDone();
+    readPool_.waitForDone();
+    // Drop results and progress the finished job already posted
+    QCoreApplication::removePostedEvents(this, QEvent::MetaCall);
+    cancel_   = false;
+    indexing_ = false;
+    ++searchGeneration_;
+    ++jumpGeneration_;
+    search_.reset();
+    hits_.clear();
+    currentHit_ = -1;
+    searching_  = false;
+    path_.clear();
+    file_.close();
+    index_.reset();
+    ++windowGeneration_;
+    window_.clear();
+    windowFirst_  = -1;
+    loadingFirst_ = -1;
+    windowStale_  = false;
+    widest_       = 0;
+    updateScrollBars();
+    viewport()->update();
+}
+
+void ScrollbackView::startIndexing() {
+    if (indexing_ || path_.isEmpty()) return;
+    indexing_ = true;
+
+    auto next = index_ ? std::make_shared<LineIndex>(*index_) : std::make_shared<LineIndex>();
+    pool_.start([this, next, path = path_] {
+        const bool complete = next->update(path, cancel_, [this](qint64 done, qint64 total) {
+            if (total <= 0 || done >= total) return;
+            const QString text = QString("indexing %1%").arg(done * 100 / total);
+            QMetaObject::invokeMethod(this, [this, text] { emit status(text); },
+                                      Qt::QueuedConnection);
+        });
+        if (cancel_) return;
+        next->save(LineIndex::cachePath(path));
+        QMetaObject::invokeMethod(this, [this, next, complete] { indexReady(next, complete); },
+                                  Qt::QueuedConnection);
+    });
+}
+
+void ScrollbackView::indexReady(std::shared_ptr<const LineIndex> index, bool complete) {
+    indexing_ = false;
+    if (path_.isEmpty()) return;
+
+    // Follow the path, which may have been rotated to a new file
+    file_.close();
+    file_.open(QIODevice::ReadOnly);
+
+    auto* sb = verticalScrollBar();
+    const bool   atBottom = sb->value() >= sb->maximum();
+    const qint64 before   = lineCount();
+    index_     = std::move(index);
+    // Offsets may have changed if the file was replaced; the old rows stay
+    // on screen until the reload arrives
+    windowStale_  = true;
+    loadingFirst_ = -1;
+    updateScrollBars();
+    if (atBottom) sb->setValue(sb->maximum());
+    viewport()->update();
+    // Nothing was indexed to search yet, or a shorter file replaced the old
+    // one and the hits no longer point at their lines
+    if (search_ && (before == 0 || lineCount() < before)) startSearch();
+
+    emit status(complete
+        ? QString("%1 lines").arg(QLocale().toString(index_->lineCount()))
+        : QString("indexing stopped"));
+}
+
+void ScrollbackView::setSearch(std::shared_ptr<const LineFilter> query) {
+    if (query && query->isTrivial()) query.reset();
+    search_ = std::move(query);
+    startSearch();
+    viewport()->update();
+}
+
+void ScrollbackView::startSearch() {
+    const quint64 generation = ++searchGeneration_;
+    hits_.clear();
+    currentHit_ = -1;
+    searching_  = search_ && index_ && !path_.isEmpty();
+    if (!searching_) {
+        reportSearch();
+        return;
+    }
+
+    // Only as far as the index reaches, so hit rows are rows the view can show
+    const qint64 end  = index_->indexedSize();
+    const qint64 rows = index_->lineCount();
+    pool_.start([this, generation, end, rows, query = search_, path = path_] {
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly)) {
+            QByteArray chunk;
+            QByteArray carry;   // start of a line continued in the next chunk
+            qint64     row = 0;
+            for (qint64 pos = 0; pos < end && row < rows; ) {
+                if (cancel_ || searchGeneration_ != generation) return;
+                const qint64 len = qMin(kScanSize, end - pos);
+                chunk.resize(len);
+                if (file.read(chunk.data(), len) != len) break;
+                pos += len;
+
+                std::vector<qint64> hits;
+                const char* p = chunk.constData();
+                for (qsizetype i = 0; i < len && row < rows; ) {
+                    const void* nl = std::memchr(p + i, '\n', size_t(len - i));
+                    const qsizetype e = nl ? static_cast<const char*>(nl) - p : len;
+                    if (!nl) {
+                        carry.append(p + i, qMin<qsizetype>(e - i, kMaxLineBytes - carry.size()));
+                        break;
+                    }
+                    // Lines within the chunk are matched in place
+                    QByteArrayView line(p + i, e - i);
+                    if (!carry.isEmpty()) {
+                        carry.append(p + i, qMin<qsizetype>(e - i, kMaxLineBytes - carry.size()));
+                        line = carry;
+                    }
+                    if (query->accepts(line.first(qMin(line.size(), kMaxLineBytes)), Severity::Plain))
+                        hits.push_back(row);
+                    carry.clear();
+                    ++row;
+                    i = e + 1;
+                }
+                if (hits.empty()) continue;
+                QMetaObject::invokeMethod(this, [this, generation, hits = std::move(hits)] {
+                    addSearchHits(generation, hits, false);
+                }, Qt::QueuedConnection);
+            }
+            // The indexed part ends in a line without a newline yet
+            if (!carry.isEmpty() && row < rows && query->accepts(carry, Severity::Plain)) {
+                const std::vector<qint64> last {row};
+                QMetaObject::invokeMethod(this, [this, generation, last] {
+                    addSearchHits(generation, last, false);
+                }, Qt::QueuedConnection);
+            }
+        }
+        QMetaObject::invokeMethod(this, [this, generation] {
+            addSearchHits(generation, {}, true);
+        }, Qt::QueuedConnection);
+    });
+    reportSearch();
+}
+
+void ScrollbackView::addSearchHits(quint64 generation, const std::vector<qint64>& rows,
+                                   bool done) {
+    if (generation != searchGeneration_) return;
+    // The scan runs front to back, so each chunk goes at the end
+    hits_.insert(hits_.end(), rows.begin(), rows.end());
+    if (!rows.empty()) viewport()->update();
+    if (done) searching_ = false;
+    reportSearch();
+}
+
+bool ScrollbackView::isHit(qint64 row) const {
+    return std::binary_search(hits_.begin(), hits_.end(), row);
+}
+
+void ScrollbackView::findNext(bool backward) {
+    if (hits_.empty()) {
+        reportSearch();
+        return;
+    }
+    auto*  sb   = verticalScrollBar();
+    qint64 from = currentHit_;
+    if (from < 0) from = sb->value() - (backward ? 0 : 1);
+
+    auto it = backward ? std::lower_bound(hits_.begin(), hits_.end(), from)
+                       : std::upper_bound(hits_.begin(), hits_.end(), from);
+    if (backward) it = it == hits_.begin() ? hits_.end() - 1 : it - 1;
+    else if (it == hits_.end()) it = hits_.begin();
+    currentHit_ = *it;
+
+    if (currentHit_ < sb->value() || currentHit_ >= sb->value() + visibleRows())
+        sb->setValue(int(qBound<qint64>(0, currentHit_ - visibleRows() / 2, sb->maximum())));
+    viewport()->update();
+    reportSearch();
+}
+
+void ScrollbackView::reportSearch() {
+    const qsizetype current = currentHit_ >= 0 && isHit(currentHit_)
+        ? qsizetype(std::lower_bound(hits_.begin(), hits_.end(), currentHit_) - hits_.begin()) + 1
+        : 0;
+    emit searchProgress(current, qsizetype(hits_.size()), !searching_);
+}
+
+qint64 ScrollbackView::lineCount() const {
+    return index_ ? index_->lineCount() : 0;
+}
+
+int ScrollbackView::visibleRows() const {
+    return qMax(1, viewport()->height() / lineHeight_);
+}
+
+void ScrollbackView::loadWindow(qint64 first) {
+    if (!index_ || path_.isEmpty() || first == loadingFirst_) return;
+    loadingFirst_ = first;
+
+    const quint64 generation = ++windowGeneration_;
+    const qint64  count      = (2 * kSpareScreens + 1) * (visibleRows() + 1);
+    readPool_.start([this, generation, first, count, index = index_, path = path_] {
+        if (cancel_ || windowGeneration_ != generation) return;
+        QFile     file(path);
+        LineBatch lines;
+        if (file.open(QIODevice::ReadOnly)) lines = readLines(file, *index, first, count);
+        QMetaObject::invokeMethod(this, [this, generation, first, lines = std::move(lines)] {
+            windowReady(generation, first, lines);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ScrollbackView::windowReady(quint64 generation, qint64 first, const LineBatch& lines) {
+    if (generation != windowGeneration_) return;
+    window_       = lines;
+    windowFirst_  = first;
+    loadingFirst_ = -1;
+    windowStale_  = false;
+
+    // Widen the horizontal range as longer lines come into view
+    qsizetype widest = widest_;
+    for (qsizetype i = 0; i < window_.size(); ++i) widest = qMax(widest, window_.line(i).size());
+    if (widest != widest_) {
+        widest_ = widest;
+        updateScrollBars();
+    }
+    viewport()->update();
+}
+
+void ScrollbackView::paintEvent(QPaintEvent* /*event*/) {
+    QPainter p(viewport());
+    p.fillRect(viewport()->rect(), kBackground);
+    p.setFont(font());
+
+    // Paint only reads memory; reload once the view comes within a screen
+    // of either end of the window (or past it). A window that already starts
+    // where a reload would is as long as the file allows until it changes.
+    const qint64 first = verticalScrollBar()->value();
+    const qint64 rows  = visibleRows() + 1;
+    const qint64 last  = windowFirst_ + window_.size();
+    const qint64 want  = qMax<qint64>(0, first - kSpareScreens * rows);
+    const bool   thin  = qMax<qint64>(0, first - rows) < windowFirst_ ||
+                         qMin(lineCount(), first + 2 * rows) > last;
+    if (windowStale_ || (thin && want != windowFirst_)) loadWindow(want);
+
+    const int x = kMargin - horizontalScrollBar()->value();
+    QList<std::pair<qsizetype, qsizetype>> spans;
+    for (qint64 row = qMax(first, windowFirst_); row < qMin(first + rows, last); ++row) {
+        const qsizetype      i    = qsizetype(row - windowFirst_);
+        const QByteArrayView line = window_.line(i);
+        const QString        text = QString::fromUtf8(line.data(), line.size());
+        const int            y    = int(row - first) * lineHeight_;
+        if (search_ && isHit(row)) {
+            search_->matchSpans(text, spans);
+            const QColor& color = row == currentHit_ ? kCurrentHit : kSearchHit;
+            for (const auto& [start, length] : spans)
+                p.fillRect(x + int(start) * charWidth_, y, int(length) * charWidth_, lineHeight_,
+                           color);
+        }
+        p.setPen(colorFor(window_.severity(i)));
+        p.drawText(x, y + ascent_, text);
+    }
+}
+
+bool ScrollbackView::jumpTo(qint64 ms) {
+    if (!index_ || lineCount() == 0 || path_.isEmpty()) return false;
+
+    // Walk forward from the last anchor at or before `ms` to the first line
+    // stamped at or after it. The next anchor qualifies by itself, so the
+    // walk never goes past it; without one it may run to the end, which is
+    // why it reads on the worker and scrolls when it is done.
+    const quint64 generation = ++jumpGeneration_;
+    const qint64  from       = index_->lineBefore(ms);
+    const qint64  next       = index_->lineAfter(ms);
+    readPool_.start([this, generation, ms, from, next, index = index_, path = path_] {
+        const qint64 until  = next >= 0 ? next : index->lineCount();
+        qint64       target = -1;
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly)) {
+            for (qint64 row = from; target < 0 && row < until; ) {
+                if (cancel_ || jumpGeneration_ != generation) return;
+                const LineBatch lines = readLines(file, *index, row,
+                                                  qMin(LineIndex::kStride, until - row));
+                if (lines.isEmpty()) break;
+                for (qsizetype i = 0; i < lines.size(); ++i) {
+                    if (parseTimestamp(lines.line(i)) >= ms) {
+                        target = row + i;
+                        break;
+                    }
+                }
+                row += lines.size();
+            }
+        }
+        if (target < 0) target = next;
+        QMetaObject::invokeMethod(this, [this, generation, target] {
+            jumpReady(generation, target);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void ScrollbackView::jumpReady(quint64 generation, qint64 target) {
+    if (generation != jumpGeneration_) return;
+    if (target >= 0) {
+        auto* sb = verticalScrollBar();
+        sb->setValue(int(qBound<qint64>(0, target, sb->maximum())));
+    }
+    emit jumped(target >= 0);
+}
+
+void ScrollbackView::updateMetrics() {
+    const QFontMetrics fm(font());
+    lineHeight_ = qMax(1, fm.lineSpacing());
+    charWidth_  = qMax(1, fm.horizontalAdvance(QLatin1Char('M')));
+    ascent_     = fm.ascent();
+    windowStale_  = true;   // sized for the old line height
+    loadingFirst_ = -1;
+    updateScrollBars();
+}
+
+void ScrollbackView::updateScrollBars() {
+    auto* vsb = verticalScrollBar();
+    vsb->setPageStep(visibleRows());
+    vsb->setSingleStep(1);
+    vsb->setRange(0, int(qBound<qint64>(0, lineCount() - visibleRows(),
+                                        std::numeric_limits<int>::max())));
+
+    auto* hsb = horizontalScrollBar();
+    const int contentWidth = int(qMin<qint64>(qint64(widest_) * charWidth_ + 2 * kMargin,
+                                              std::numeric_limits<int>::max()));
+    hsb->setPageStep(viewport()->width());
+    hsb->setSingleStep(charWidth_ * 4);
+    hsb->setRange(0, qMax(0, contentWidth - viewport()->width()));
+}
+
+void ScrollbackView::resizeEvent(QResizeEvent* event) {
+    QAbstractScrollArea::resizeEvent(event);
+    windowStale_  = true;   // sized for the old height
+    loadingFirst_ = -1;
+    updateScrollBars();
+}
+
+void ScrollbackView::changeEvent(QEvent* event) {
+    if (event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange)
+        updateMetrics();
+    QAbstractScrollArea::changeEvent(event);
+}
+
+void ScrollbackView::showEvent(QShowEvent* event) {
+    QAbstractScrollArea::showEvent(event);
+    if (!path_.isEmpty()) refreshTimer_->start();
+}
+
+void ScrollbackView::hideEvent(QHideEvent* event) {
+    refreshTimer_->stop();
+    QAbstractScrollArea::hideEvent(event);
+}
+
+void ScrollbackView::keyPressEvent(QKeyEvent* event) {
+    if (event->key() == Qt::Key_End) {
+        verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+    } else if (event->key() == Qt::Key_Home) {
+        verticalScrollBar()->setValue(0);
+    } else {
+        QAbstractScrollArea::keyPressEvent(event);
+    }
+}
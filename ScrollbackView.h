@@ -0,0 +1,123 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "LineBatch.h"
+#include "LineFilter.h"
+#include "LineIndex.h"
+
+#include <QAbstractScrollArea>
+#include <QFile>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QTimer;
+
+// Read-only view over a whole log file, for scrolling back past the tail
+// buffer. A LineIndex, cached across sessions and extended in the
+// background, maps rows and times to file offsets; only a few screens
+// around the rows shown are read, on a worker thread, so memory stays flat
+// however large the file is and painting never touches the disk. A
+// search streams the indexed part of the file on the same worker thread and
+// keeps only the row numbers of its hits.
+class ScrollbackView : public QAbstractScrollArea {
+    Q_OBJECT
+
+public:
+    explicit ScrollbackView(QWidget* parent = nullptr);
+    ~ScrollbackView() override;
+
+    // Shows `path` from its cached index right away and brings the index up
+    // to date in the background.
+    void open(const QString& path);
+    void close();
+
+    // Looks for the first line stamped at or after `ms` (see parseTimestamp())
+    // in the background and scrolls to it; jumped() tells how it went. False
+    // if there is nothing to search.
+    bool jumpTo(qint64 ms);
+
+    // Finds lines the query accepts in the file as indexed when the search
+    // starts; nullptr ends the search.
+    void setSearch(std::shared_ptr<const LineFilter> query);
+    // Scrolls to the next or previous hit, wrapping around.
+    void findNext(bool backward = false);
+
+signals:
+    // Indexing progress or the number of lines indexed, for display.
+    void status(const QString& text);
+    // `current` is the 1-based selected hit or 0; `done` once the scan finished.
+    void searchProgress(qsizetype current, qsizetype total, bool done);
+    // A jumpTo() finished; `found` is false if no line was stamped that late.
+    void jumped(bool found);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void changeEvent(QEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+
+private:
+    void startIndexing();
+    void indexReady(std::shared_ptr<const LineIndex> index, bool complete);
+    void startSearch();
+    void addSearchHits(quint64 generation, const std::vector<qint64>& rows, bool done);
+    bool isHit(qint64 row) const;
+    void reportSearch();
+    // Reads the window starting at row `first` in the background.
+    void      loadWindow(qint64 first);
+    void      windowReady(quint64 generation, qint64 first, const LineBatch& lines);
+    void      jumpReady(quint64 generation, qint64 target);
+    qint64    lineCount() const;
+    int       visibleRows() const;
+    void      updateMetrics();
+    void      updateScrollBars();
+
+    QString                          path_;
+    QFile                            file_;
+    std::shared_ptr<const LineIndex> index_;
+    qint64                           windowFirst_  = -1;      // row of window_.line(0)
+    LineBatch                        window_;                 // rows on and around screen
+    qint64                           loadingFirst_ = -1;      // window being read
+    bool                             windowStale_  = false;   // index changed under it
+    std::atomic<quint64>             windowGeneration_ {0};
+    std::atomic<quint64>             jumpGeneration_   {0};
+    qsizetype                        widest_       = 0;
+
+    int                   lineHeight_ = 14;
+    int                   charWidth_  = 7;
+    int                   ascent_     = 11;
+
+    QTimer*               refreshTimer_ = nullptr;   // re-indexes the growing file
+    bool                  indexing_     = false;
+    std::atomic<bool>     cancel_ {false};
+
+    std::shared_ptr<const LineFilter> search_;
+    std::vector<qint64>   hits_;              // rows, ascending
+    qint64                currentHit_ = -1;   // row
+    bool                  searching_  = false;
+    std::atomic<quint64>  searchGeneration_ {0};
+    QThreadPool           pool_;
+    // Page reads, kept off pool_ so a long index update or search never
+    // holds up the screen
+    QThreadPool           readPool_;
+};
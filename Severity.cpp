@@ -0,0 +1,114 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "Severity.h"
+
+#include "JsonLine.h"
+
+#include <array>
+#include <string_view>
+
+namespace {
+
+// When several keywords appear the most severe wins, as with the old
+// sequential contains() checks
+constexpr int rank(Severity s) {
+    switch (s) {
+        case Severity::Error:   return 4;
+        case Severity::Warning: return 3;
+        case Severity::Debug:   return 2;
+        case Severity::Info:    return 1;
+        default:                return 0;
+    }
+}
+
+// Keywords bucketed by first letter, so each byte of the head costs one
+// table lookup and at most a couple of short compares
+struct Bucket {
+    quint8 count    = 0;
+    quint8 index[2] = {};
+};
+
+constexpr std::array<Bucket, 26> makeBuckets() {
+    std::array<Bucket, 26> buckets{};
+    for (quint8 i = 0; i < std::size(kSeverityKeywords); ++i) {
+        Bucket& b = buckets[size_t(kSeverityKeywords[i].word[0] - 'A')];
+        b.index[b.count++] = i;   // overflow fails constant evaluation
+    }
+    return buckets;
+}
+
+constexpr auto kBuckets = makeBuckets();
+
+// scanLines() relies on the first matching keyword being the most severe
+constexpr bool mostSevereFirst() {
+    for (size_t i = 1; i < std::size(kSeverityKeywords); ++i)
+        if (rank(kSeverityKeywords[i].severity) > rank(kSeverityKeywords[i - 1].severity))
+            return false;
+    return true;
+}
+
+static_assert(mostSevereFirst());
+
+constexpr char upper(char c) {
+    return (c >= 'a' && c <= 'z') ? char(c - 'a' + 'A') : c;
+}
+
+}  // namespace
+
+Severity classifyLine(QByteArrayView line) {
+    Severity json;
+    if (JsonScanner::looksLikeObject(line) && jsonLineSeverity(line, json)) return json;
+    return classifyKeywords(line);
+}
+
+Severity classifyKeywords(QByteArrayView line) {
+    const char*     d    = line.data();
+    const qsizetype n    = qMin(line.size(), kSeverityHeadBytes);
+    Severity        best = Severity::Plain;
+
+    for (qsizetype i = 0; i < n; ++i) {
+        const char c = upper(d[i]);
+        if (c < 'A' || c > 'Z') continue;
+
+        const Bucket& b = kBuckets[size_t(c - 'A')];
+        for (quint8 k = 0; k < b.count; ++k) {
+            const SeverityKeyword& kw  = kSeverityKeywords[b.index[k]];
+            const qsizetype        len = qsizetype(kw.word.size());
+            if (i + len > n || rank(kw.severity) <= rank(best)) continue;
+
+            qsizetype j = 1;
+            while (j < len && upper(d[i + j]) == kw.word[size_t(j)]) ++j;
+            if (j == len) {
+                best = kw.severity;
+                if (best == Severity::Error) return best;
+            }
+        }
+    }
+    return best;
+}
+
+QColor colorFor(Severity severity) {
+    // Indexed by Severity
+    static const QColor kPalette[] = {
+        QColor("#c8cee8"),   // Plain
+        QColor("#ff5555"),   // Error
+        QColor("#ffb86c"),   // Warning
+        QColor("#6272a4"),   // Debug
+        QColor("#8be9fd"),   // Info
+    };
+    return kPalette[static_cast<quint8>(severity)];
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <QByteArrayView>
+#include <QColor>
+
+#include <string_view>
+
+// Per-line severity, stored as one byte per retained line.
+enum class Severity : quint8 {
+    Plain,
+    Error,
+    Warning,
+    Debug,
+    Info,
+};
+
+// Keywords classifyKeywords() looks for, case-insensitively, in the first
+// kSeverityHeadBytes of a line. Listed most severe first, and the most
+// severe keyword found wins, so the first one that matches decides.
+struct SeverityKeyword {
+    std::string_view word;
+    Severity         severity;
+};
+
+// Only the start of a line is inspected; avoids scanning megabyte-long lines
+inline constexpr qsizetype kSeverityHeadBytes = 40;
+
+inline constexpr SeverityKeyword kSeverityKeywords[] = {
+    {"ERROR",   Severity::Error},
+    {"FATAL",   Severity::Error},
+    {"CRIT",    Severity::Error},
+    {"EMERG",   Severity::Error},
+    {"ALERT",   Severity::Error},
+    {"WARN",    Severity::Warning},
+    {"DEBUG",   Severity::Debug},
+    {"TRACE",   Severity::Debug},
+    {"VERBOSE", Severity::Debug},
+    {"INFO",    Severity::Info},
+    {"NOTICE",  Severity::Info},
+};
+
+// Classifies a raw UTF-8 line from keywords near its start. A JSON object
+// line is classified by its level field instead, if it has one early on.
+Severity classifyLine(QByteArrayView line);
+// Keyword matching alone, as used for plain lines.
+Severity classifyKeywords(QByteArrayView line);
+QColor   colorFor(Severity severity);
+
+// Ordering used by severity thresholds: debug < plain and info < warning < error.
+constexpr int severityLevel(Severity severity) {
+    switch (severity) {
+        case Severity::Debug:   return 0;
+        case Severity::Warning: return 2;
+        case Severity::Error:   return 3;
+        default:                return 1;
+    }
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "SeverityGraph.h"
+
+#include "Severity.h"
+
+#include <QPainter>
+
+#include <algorithm>
+
+namespace {
+
+const QColor kVolume("#2d3748");
+constexpr int kBarWidth = 2;
+
+}  // namespace
+
+SeverityGraph::SeverityGraph(QWidget* parent) : QWidget(parent) {
+    setAttribute(Qt::WA_OpaquePaintEvent, false);
+    setFixedSize(sizeHint());
+    updateToolTip();
+}
+
+QSize SeverityGraph::sizeHint() const {
+    return {kSeconds * kBarWidth, 18};
+}
+
+void SeverityGraph::push(const std::array<qint64, IngestCounters::kSeverities>& counts) {
+    Second& s  = ring_[size_t(head_)];
+    s.errors   = counts[size_t(Severity::Error)];
+    s.warnings = counts[size_t(Severity::Warning)];
+    s.total    = 0;
+    for (qint64 n : counts) s.total += n;
+    head_   = (head_ + 1) % kSeconds;
+    filled_ = qMin(filled_ + 1, kSeconds);
+    updateToolTip();
+    update();
+}
+
+void SeverityGraph::clear() {
+    ring_.fill({});
+    head_   = 0;
+    filled_ = 0;
+    updateToolTip();
+    update();
+}
+
+void SeverityGraph::paintEvent(QPaintEvent* /*event*/) {
+    QPainter p(this);
+    qint64 peak = 1;
+    for (const Second& s : ring_) peak = std::max(peak, s.total);
+
+    // Oldest on the left; a second with any errors or warnings gets at least
+    // a pixel of colour, however busy the rest of the minute was
+    const int  h      = height();
+    const auto scaled = [&](qint64 n) {
+        return n > 0 ? qMax(1, int(n * h / peak)) : 0;
+    };
+    for (int i = 0; i < filled_; ++i) {
+        const Second& s = ring_[size_t((head_ - filled_ + i + kSeconds) % kSeconds)];
+        const int x     = (kSeconds - filled_ + i) * kBarWidth;
+        const int total = scaled(s.total);
+        const int error = scaled(s.errors);
+        const int warn  = qMin(scaled(s.warnings), h - error);
+        p.fillRect(x, h - total, kBarWidth, total, kVolume);
+        p.fillRect(x, h - error, kBarWidth, error, colorFor(Severity::Error));
+        p.fillRect(x, h - error - warn, kBarWidth, warn, colorFor(Severity::Warning));
+    }
+}
+
+void SeverityGraph::updateToolTip() {
+    qint64 errors = 0, warnings = 0, total = 0;
+    for (const Second& s : ring_) {
+        errors   += s.errors;
+        warnings += s.warnings;
+        total    += s.total;
+    }
+    setToolTip(QString("Last %1 s: %2 lines, %3 warnings, %4 errors")
+                   .arg(filled_).arg(total).arg(warnings).arg(errors));
+}
@@ -0,0 +1,58 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "IngestMetrics.h"
+
+#include <QWidget>
+
+#include <array>
+
+// Lines per second over the last minute as a tiny stacked bar chart for the
+// header bar: every line in a dim bar, warnings and errors stacked on top in
+// their colours. Fed once a second from the source's severity counters, so
+// the readers only pay for an atomic add per batch.
+class SeverityGraph : public QWidget {
+    Q_OBJECT
+
+public:
+    static constexpr int kSeconds = 60;
+
+    explicit SeverityGraph(QWidget* parent = nullptr);
+
+    // Adds one second's counts, indexed by Severity.
+    void push(const std::array<qint64, IngestCounters::kSeverities>& counts);
+    void clear();
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    struct Second {
+        qint64 errors   = 0;
+        qint64 warnings = 0;
+        qint64 total    = 0;
+    };
+
+    void updateToolTip();
+
+    std::array<Second, kSeconds> ring_ {};
+    int                          head_   = 0;   // next slot to write
+    int                          filled_ = 0;
+};
@@ -0,0 +1,495 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "TailSource.h"
+
+#include "FileTailWorker.h"
+#include "LineMerger.h"
+#include "RemoteConnection.h"
+#ifdef LOGTAIL_HAVE_SYSTEMD
+#include "JournalReader.h"
+#endif
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QProcess>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Null unless the config asks for filtering at the source and the filter
+// actually rejects something
+std::shared_ptr<const LineFilter> sourceFilter(const LogTailConfig& config) {
+    if (!config.filterAtSource) return nullptr;
+    auto filter = std::make_shared<const LineFilter>(config.filter);
+    return filter->isTrivial() ? nullptr : filter;
+}
+
+QString sourceKey(const LogTailConfig& config) {
+    QString key;
+    if (config.source == LogTailConfig::Source::File) {
+        const QFileInfo info(config.filePath);
+        const QString canonical = info.canonicalFilePath();
+        key = "file:" + (canonical.isEmpty() ? info.absoluteFilePath() : canonical);
+        // Stitched sources start with older lines than plain ones
+        if (config.stitchRotated) key += "|rotated";
+    } else if (config.source == LogTailConfig::Source::Remote) {
+        // Different agents on one host are different streams
+        key = "remote:" + config.remoteHost + ":" + config.remotePath + "|agent:" +
+              config.remoteAgent;
+    } else {
+        key = "journal:" + config.journalUnit;
+    }
+    if (config.overload != IngestQueue::Policy::DropOldest)
+        key += QString("|overload%1").arg(int(config.overload));
+    if (config.dedup != LineStore::Dedup::Off)
+        key += QString("|dedup%1").arg(int(config.dedup));
+    // A source filtered at the source holds different lines, so it is not shared
+    // with unfiltered viewers of the same file
+    if (const auto filter = sourceFilter(config)) {
+        const LineFilter::Spec& f = filter->spec();
+        key += QString("|%1%2%3|%4").arg(int(f.regex)).arg(int(f.exclude)).arg(f.minLevel)
+                                    .arg(f.pattern);
+    }
+    return key;
+}
+
+// journalctl -p already dropped everything below the threshold, so a line
+// whose text looks less severe is still at least that severe
+Severity atLeast(Severity severity, int level) {
+    constexpr Severity kFloor[] = {Severity::Debug, Severity::Plain,
+                                   Severity::Warning, Severity::Error};
+    return severityLevel(severity) >= level ? severity : kFloor[qBound(0, level, 3)];
+}
+
+// The file source may be a ';'-separated list of paths and glob patterns
+QStringList expandPaths(const QString& spec) {
+    QStringList paths;
+    for (const QString& part : spec.split(';', Qt::SkipEmptyParts)) {
+        const QString entry = part.trimmed();
+        if (entry.isEmpty()) continue;
+
+        const QFileInfo info(entry);
+        const QString   name = info.fileName();
+        if (!name.contains(QLatin1Char('*')) && !name.contains(QLatin1Char('?')) &&
+            !name.contains(QLatin1Char('['))) {
+            paths.append(info.absoluteFilePath());
+            continue;
+        }
+        const QDir dir = info.absoluteDir();
+        for (const QString& match : dir.entryList({name}, QDir::Files, QDir::Name))
+            paths.append(dir.absoluteFilePath(match));
+    }
+    paths.removeDuplicates();
+    return paths;
+}
+
+// GUI thread only, like the widgets that use it
+QHash<QString, std::weak_ptr<TailSource>>& registry() {
+    static QHash<QString, std::weak_ptr<TailSource>> sources;
+    return sources;
+}
+
+}  // namespace
+
+std::shared_ptr<TailSource> TailSource::acquire(const LogTailConfig& config) {
+    const QString key = sourceKey(config);
+    std::weak_ptr<TailSource>& slot = registry()[key];
+    if (auto source = slot.lock()) return source;
+
+    std::shared_ptr<TailSource> source(new TailSource(config, key));
+    slot = source;
+    return source;
+}
+
+TailSource::TailSource(const LogTailConfig& config, const QString& key)
+    : config_(config), key_(key), filter_(sourceFilter(config)),
+      counters_(std::make_shared<IngestCounters>()) {
+    qRegisterMetaType<LineBatch>();
+
+    // New lines are collected in queue_ and appended at most once per
+    // flush interval, however fast the source produces them
+    queue_.setPolicy(config.overload);
+    store_.setDedup(config.dedup);
+    flushTimer_ = new QTimer(this);
+    flushTimer_->setSingleShot(true);
+    connect(flushTimer_, &QTimer::timeout, this, &TailSource::flushPending);
+}
+
+TailSource::~TailSource() {
+    stop();
+    auto it = registry().find(key_);
+    if (it != registry().end() && it->expired())
+        registry().erase(it);
+}
+
+// ── Viewers ───────────────────────────────────────────────────────────────────
+
+void TailSource::addViewer(const QObject* viewer, int maxLines, int flushMs) {
+    viewers_.insert(viewer, {maxLines, flushMs});
+    const int oldMax = maxLines_;
+    applyLimits();
+
+    if (!running_)
+        start();
+    else if (maxLines_ > oldMax)
+        restart();   // seed again so the new viewer gets its full buffer
+}
+
+void TailSource::removeViewer(const QObject* viewer) {
+    viewers_.remove(viewer);
+    if (viewers_.isEmpty()) return;
+    applyLimits();
+    emit appended();   // remaining views resync if the store shrank
+}
+
+void TailSource::applyLimits() {
+    maxLines_ = 0;
+    flushMs_  = 1000;
+    for (const Limits& l : std::as_const(viewers_)) {
+        maxLines_ = std::max(maxLines_, l.maxLines);
+        flushMs_  = std::min(flushMs_, l.flushMs);
+    }
+    store_.setCapacity(maxLines_);
+    queue_.setCapacity(maxLines_);
+}
+
+// ── Reader lifecycle ──────────────────────────────────────────────────────────
+
+void TailSource::start() {
+    running_ = true;
+    if (config_.source == LogTailConfig::Source::File)
+        startFileTail();
+    else if (config_.source == LogTailConfig::Source::Remote)
+        startRemote();
+    else
+        startJournal();
+}
+
+void TailSource::stop() {
+    for (QObject* reader : std::as_const(readers_))
+        disconnect(reader, nullptr, this, nullptr);
+    for (QThread* thread : std::as_const(readerThreads_)) {
+        thread->quit();
+        thread->wait();
+        delete thread;
+    }
+    readerThreads_.clear();
+    readers_.clear();   // deleted via QThread::finished
+    // Drop batches the old readers already queued for us
+    QCoreApplication::removePostedEvents(this, QEvent::MetaCall);
+    counters_->inFlight = 0;
+    if (pollingFiles_ > 0) {
+        pollingFiles_ = 0;
+        pollingReason_.clear();
+        emit watchModeChanged();
+    }
+    flushTimer_->stop();
+    queue_.clear();
+    if (remote_) {
+        disconnect(remote_.get(), nullptr, this, nullptr);
+        remote_->unsubscribe(remoteStream_);
+        remote_.reset();
+        remoteStream_ = -1;
+    }
+    if (process_) {
+        process_->kill();
+        process_->waitForFinished(500);
+        delete process_;
+        process_ = nullptr;
+    }
+    running_ = false;
+}
+
+void TailSource::restart() {
+    stop();
+    store_.clear();
+    emit cleared();
+    start();
+}
+
+// Moves a reader onto its own thread; it is deleted when the thread stops
+void TailSource::startReaderThread(QObject* reader) {
+    auto* thread = new QThread(this);
+    reader->moveToThread(thread);
+    connect(thread, &QThread::finished, reader, &QObject::deleteLater);
+    thread->start();
+    readerThreads_.append(thread);
+    readers_.append(reader);
+}
+
+// ── File tail ─────────────────────────────────────────────────────────────────
+
+void TailSource::startFileTail() {
+    const QStringList paths = expandPaths(config_.filePath);
+    if (paths.size() > 1) {
+        startMergedTail(paths);
+        return;
+    }
+    if (paths.isEmpty()) {
+        appendMessage(QString("No files match: %1").arg(config_.filePath), Severity::Error);
+        return;
+    }
+
+    auto* worker = new FileTailWorker();
+    worker->setFilter(filter_);
+    worker->setCounters(counters_);
+    worker->setStitchRotated(config_.stitchRotated);
+    connect(worker, &FileTailWorker::linesReady, this, &TailSource::queueLines,
+            Qt::DirectConnection);
+    connect(worker, &FileTailWorker::historyReady, this, &TailSource::prependHistory);
+    // The worker drains the old file first, so earlier lines stay valid
+    connect(worker, &FileTailWorker::rotated, this, [this](const QString& how) {
+        appendMessage(QString("─── log %1 ───").arg(how), Severity::Debug);
+    });
+    connect(worker, &FileTailWorker::failed, this, [this](const QString& msg) {
+        appendMessage(msg, Severity::Error);
+    });
+    watchWorker(worker);
+
+    startReaderThread(worker);
+    QMetaObject::invokeMethod(worker,
+        [worker, path = paths.front(), maxLines = maxLines_, flushMs = flushMs_]() {
+            worker->start(path, maxLines, flushMs);
+        }, Qt::QueuedConnection);
+}
+
+// Several files shown as one stream: each is read on its own thread and a
+// LineMerger interleaves them by timestamp before they reach the store
+void TailSource::startMergedTail(const QStringList& paths) {
+    QStringList labels;
+    for (const QString& path : paths)
+        labels.append(QFileInfo(path).fileName());
+
+    auto* merger = new LineMerger(labels);
+    merger->setCounters(counters_);
+    connect(merger, &LineMerger::linesReady, this, &TailSource::queueLines,
+            Qt::DirectConnection);
+    startReaderThread(merger);
+    QMetaObject::invokeMethod(merger,
+        [merger, maxLines = maxLines_, flushMs = flushMs_]() {
+            merger->start(maxLines, flushMs);
+        }, Qt::QueuedConnection);
+
+    for (qsizetype i = 0; i < paths.size(); ++i) {
+        auto* worker = new FileTailWorker();
+        worker->setFilter(filter_);
+        worker->setCounters(counters_);
+        connect(worker, &FileTailWorker::linesReady, merger,
+                [merger, source = int(i)](const LineBatch& lines) {
+                    merger->push(source, lines);
+                });
+        connect(worker, &FileTailWorker::rotated, this,
+                [this, label = labels[i]](const QString& how) {
+                    appendMessage(QString("─── %1 %2 ───").arg(label, how), Severity::Debug);
+                });
+        connect(worker, &FileTailWorker::failed, this, [this](const QString& msg) {
+            appendMessage(msg, Severity::Error);
+        });
+        watchWorker(worker);
+
+        startReaderThread(worker);
+        QMetaObject::invokeMethod(worker,
+            [worker, path = paths[i], maxLines = maxLines_, flushMs = flushMs_]() {
+                worker->start(path, maxLines, flushMs);
+            }, Qt::QueuedConnection);
+    }
+}
+
+void TailSource::watchWorker(FileTailWorker* worker) {
+    connect(worker, &FileTailWorker::pollingStarted, this, [this](const QString& reason) {
+        ++pollingFiles_;
+        pollingReason_ = reason;
+        emit watchModeChanged();
+    });
+}
+
+// ── Journal ───────────────────────────────────────────────────────────────────
+
+void TailSource::startJournal() {
+#ifdef LOGTAIL_HAVE_SYSTEMD
+    auto* reader = new JournalReader();
+    reader->setFilter(filter_);
+    reader->setCounters(counters_);
+    connect(reader, &JournalReader::linesReady, this, &TailSource::queueLines,
+            Qt::DirectConnection);
+    connect(reader, &JournalReader::unavailable, this, [this]() {
+        stop();
+        running_ = true;
+        startJournalctl();
+    });
+
+    startReaderThread(reader);
+    QMetaObject::invokeMethod(reader,
+        [reader, unit = config_.journalUnit, maxLines = maxLines_, flushMs = flushMs_]() {
+            reader->start(unit, maxLines, flushMs);
+        }, Qt::QueuedConnection);
+#else
+    startJournalctl();
+#endif
+}
+
+// Subprocess fallback when libsystemd is unavailable
+void TailSource::startJournalctl() {
+    QStringList args = {"-f", "-n", "50", "--no-pager", "--output=short-iso"};
+    if (!config_.journalUnit.isEmpty())
+        args << "-u" << config_.journalUnit;
+    // Let journalctl drop what it can; the pattern is still checked on our
+    // side, since --grep only sees the message and cannot exclude
+    const int maxPriority = filter_ ? filter_->maxPriority() : -1;
+    if (maxPriority >= 0)
+        args << "-p" << QString::number(maxPriority);
+    if (const QString grep = filter_ ? filter_->grepPattern() : QString(); !grep.isEmpty())
+        args << "--grep" << grep;
+
+    process_ = new QProcess(this);
+    connect(process_, &QProcess::readyReadStandardOutput,
+            this, &TailSource::onJournalOutput);
+    connect(process_, &QProcess::errorOccurred, this,
+            [this](QProcess::ProcessError) {
+                appendMessage("journalctl: failed to start — is systemd available?",
+                              Severity::Error);
+            });
+    process_->start("journalctl", args);
+}
+
+void TailSource::onJournalOutput() {
+    const qint64 t0    = monotonicNs();
+    const int    floor = filter_ ? filter_->spec().minLevel : 0;
+    LineBatch lines;
+    lines.noticedNs = t0;
+    while (process_->canReadLine()) {
+        const QByteArray raw = process_->readLine();
+        const LineRecord r   = makeRecord(raw.constData(), 0, raw.size());
+        if (r.length == 0) continue;
+        const QByteArrayView line     = QByteArrayView(raw).sliced(r.offset, r.length);
+        const Severity       severity = atLeast(r.severity, floor);
+        if (filter_ && !filter_->accepts(line, severity)) {
+            IngestCounters::add(counters_->filtered, 1);
+            continue;
+        }
+        lines.append(line, severity);
+    }
+    counters_->addRead(monotonicNs() - t0);
+    IngestCounters::add(counters_->lines, lines.size());
+    IngestCounters::add(counters_->bytes, lines.data.size());
+    enqueue(lines);
+}
+
+// ── Remote ────────────────────────────────────────────────────────────────────
+
+// Streams from one host share a single ssh connection
+void TailSource::startRemote() {
+    remote_ = RemoteConnection::acquire(config_.remoteHost, config_.remoteAgent);
+    connect(remote_.get(), &RemoteConnection::linesReady, this,
+            [this](int stream, const LineBatch& lines) {
+                if (stream == remoteStream_) onRemoteLines(lines);
+            });
+    connect(remote_.get(), &RemoteConnection::reset, this, [this](int stream) {
+        if (stream != remoteStream_) return;
+        flushTimer_->stop();
+        queue_.clear();
+        store_.clear();
+        emit cleared();
+    });
+    connect(remote_.get(), &RemoteConnection::message, this,
+            [this](int stream, const QString& text, Severity severity) {
+                if (stream == remoteStream_ || stream < 0) appendMessage(text, severity);
+            });
+    remoteStream_ = remote_->subscribe(config_.remotePath, maxLines_);
+}
+
+void TailSource::onRemoteLines(const LineBatch& lines) {
+    LineBatch kept;
+    if (filter_) {
+        kept.noticedNs = lines.noticedNs;
+        for (qsizetype i = 0; i < lines.size(); ++i) {
+            if (filter_->accepts(lines.line(i), lines.severity(i)))
+                kept.append(lines.line(i), lines.severity(i));
+        }
+        IngestCounters::add(counters_->filtered, lines.size() - kept.size());
+    }
+    const LineBatch& batch = filter_ ? kept : lines;
+    IngestCounters::add(counters_->lines, batch.size());
+    IngestCounters::add(counters_->bytes, batch.data.size());
+    enqueue(batch);
+}
+
+// ── Line delivery ─────────────────────────────────────────────────────────────
+
+// Runs on the reader's thread: the batch goes straight into the bounded
+// queue instead of piling up as queued signals
+void TailSource::queueLines(const LineBatch& lines) {
+    IngestCounters::add(counters_->inFlight, -1);
+    enqueue(lines);
+}
+
+void TailSource::enqueue(const LineBatch& lines) {
+    // Tallied per batch, so a batch costs one atomic add per severity in it
+    std::array<qint64, IngestCounters::kSeverities> counts {};
+    for (const LineRecord& r : lines.records) ++counts[size_t(r.severity)];
+    for (size_t i = 0; i < counts.size(); ++i)
+        if (counts[i] > 0) IngestCounters::add(counters_->severities[i], counts[i]);
+
+    const IngestQueue::PushResult result = queue_.push(lines);
+    if (result.shed > 0) IngestCounters::add(counters_->overflowed, result.shed);
+    if (!result.wake) return;
+    if (QThread::currentThread() == thread()) {
+        scheduleFlush();
+    } else {
+        QMetaObject::invokeMethod(this, &TailSource::scheduleFlush, Qt::QueuedConnection);
+    }
+}
+
+void TailSource::scheduleFlush() {
+    if (!flushTimer_->isActive())
+        flushTimer_->start(flushMs_);
+}
+
+void TailSource::flushPending() {
+    const LineBatch lines = queue_.take();
+    store_.append(lines);
+    if (lines.isEmpty()) return;
+    lastNoticedNs_ = lines.noticedNs;
+    emit appended();
+}
+
+void TailSource::prependHistory(const LineBatch& older) {
+    // The store only appends, so it is rebuilt with the history in front of
+    // what it holds; the capacity still keeps the newest lines. Folded
+    // repeats come back as single rows.
+    flushTimer_->stop();
+    flushPending();
+    LineBatch all = older;
+    for (qsizetype row = 0; row < store_.size(); ++row)
+        all.append(store_.line(row), store_.severity(row));
+    store_.clear();
+    emit cleared();
+    store_.append(all);
+    emit appended();
+}
+
+void TailSource::appendMessage(const QString& text, Severity severity) {
+    flushTimer_->stop();
+    flushPending();
+    store_.append(text.toUtf8(), severity);
+    emit appended();
+}
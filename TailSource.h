@@ -0,0 +1,136 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "IngestMetrics.h"
+#include "IngestQueue.h"
+#include "LineBatch.h"
+#include "LineFilter.h"
+#include "LineStore.h"
+#include "LogTailConfig.h"
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+
+#include <memory>
+
+class FileTailWorker;
+class QProcess;
+class QThread;
+class RemoteConnection;
+class QTimer;
+
+// One reader per unique log source, shared by every widget that shows it.
+// Owns the reader thread (or journalctl process) and the LineStore the lines
+// land in; widgets attach as viewers and render their own window of the
+// store. Sources are handed out by acquire() and stop when the last
+// shared_ptr is released. A config that filters at the source gets a source
+// of its own whose readers drop rejected lines before they are stored.
+class TailSource : public QObject {
+    Q_OBJECT
+
+public:
+    // Returns the running source for config's file or journal unit, creating
+    // it if no widget is showing that source yet.
+    static std::shared_ptr<TailSource> acquire(const LogTailConfig& config);
+
+    ~TailSource() override;
+
+    const LineStore& store() const { return store_; }
+
+    // Ingestion counters, shared with the readers.
+    const IngestCounters& counters() const { return *counters_; }
+    // Lines waiting for the next flush.
+    qint64 pendingLines() const { return queue_.size(); }
+    // When the reader noticed the change behind the last flush, see LineBatch.
+    qint64 lastNoticedNs() const { return lastNoticedNs_; }
+    // File sources: how many of the files are polled rather than followed
+    // through inotify alone, and why the last one started polling.
+    int     pollingFiles() const { return pollingFiles_; }
+    QString pollingReason() const { return pollingReason_; }
+
+    // The store keeps the largest maxLines among viewers and flushes at the
+    // fastest requested interval. Reseeds if a viewer needs more lines.
+    void addViewer(const QObject* viewer, int maxLines, int flushMs);
+    void removeViewer(const QObject* viewer);
+
+signals:
+    // New lines were appended to the store.
+    void appended();
+    // The store was emptied (reseed).
+    void cleared();
+    // pollingFiles() changed.
+    void watchModeChanged();
+
+private:
+    TailSource(const LogTailConfig& config, const QString& key);
+
+    struct Limits {
+        int maxLines;
+        int flushMs;
+    };
+
+    void start();
+    void stop();
+    void restart();
+    void applyLimits();
+    void startReaderThread(QObject* reader);
+    void startFileTail();
+    void startMergedTail(const QStringList& paths);
+    void watchWorker(FileTailWorker* worker);
+    void startJournal();
+    void startJournalctl();
+    void onJournalOutput();
+    void startRemote();
+    void onRemoteLines(const LineBatch& lines);
+
+    // From a reader thread; queueLines() books the batch as delivered
+    void queueLines(const LineBatch& lines);
+    // Thread-safe; wakes the GUI thread on the first batch since a flush
+    void enqueue(const LineBatch& lines);
+    void scheduleFlush();
+    void flushPending();
+    // Puts a file's rotated history in front of everything stored.
+    void prependHistory(const LineBatch& older);
+    void appendMessage(const QString& text, Severity severity);
+
+    LogTailConfig                 config_;    // source settings only; filters come through filter_
+    QString                       key_;       // registry key
+    // Applied by the readers before lines are queued; null unless the
+    // config filters at the source
+    std::shared_ptr<const LineFilter> filter_;
+    std::shared_ptr<IngestCounters>   counters_;
+    qint64                        lastNoticedNs_ = 0;
+    QHash<const QObject*, Limits> viewers_;
+    int                           maxLines_     = 0;
+    int                           flushMs_      = 50;
+    bool                          running_      = false;
+
+    LineStore                     store_;
+    IngestQueue                   queue_;     // readers to the flush timer
+    QTimer*                       flushTimer_   = nullptr;
+    // One thread per reader: FileTailWorkers, a LineMerger or a JournalReader
+    QList<QThread*>               readerThreads_;
+    QList<QObject*>               readers_;
+    QProcess*                     process_      = nullptr;
+    // Remote source: the shared connection to the host and our stream on it
+    std::shared_ptr<RemoteConnection> remote_;
+    int                           remoteStream_ = -1;
+    int                           pollingFiles_ = 0;
+    QString                       pollingReason_;
+};
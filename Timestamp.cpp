@@ -0,0 +1,218 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "Timestamp.h"
+
+#include <ctime>
+
+namespace {
+
+// How far into a line a bracketed timestamp may start (access logs put the
+// client address and ident fields first)
+constexpr qsizetype kSearchBytes = 64;
+
+// Days since 1970-01-01 for a proleptic Gregorian date
+constexpr qint64 daysFromCivil(qint64 y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const qint64   era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = unsigned(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + qint64(doe) - 719468;
+}
+
+static_assert(daysFromCivil(1970, 1, 1) == 0);
+static_assert(daysFromCivil(2000, 3, 1) == 11017);
+
+class Cursor {
+public:
+    Cursor(const char* p, const char* end) : p_(p), end_(end) {}
+
+    bool digits(int n, int& out) {
+        if (end_ - p_ < n) return false;
+        int v = 0;
+        for (int i = 0; i < n; ++i) {
+            const char c = p_[i];
+            if (c < '0' || c > '9') return false;
+            v = v * 10 + (c - '0');
+        }
+        p_ += n;
+        out = v;
+        return true;
+    }
+    bool lit(char c) {
+        if (p_ == end_ || *p_ != c) return false;
+        ++p_;
+        return true;
+    }
+    bool oneOf(char a, char b) { return lit(a) || lit(b); }
+    char peek() const { return p_ == end_ ? '\0' : *p_; }
+    void skip() { if (p_ != end_) ++p_; }
+    bool month(int& out) {
+        static constexpr char kMonths[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+        if (end_ - p_ < 3) return false;
+        for (int m = 0; m < 12; ++m) {
+            const char* name = kMonths + m * 3;
+            if (p_[0] == name[0] && p_[1] == name[1] && p_[2] == name[2]) {
+                p_ += 3;
+                out = m + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+bool validTime(int mo, int d, int h, int mi, int s) {
+    return mo >= 1 && mo <= 12 && d >= 1 && d <= 31 && h < 24 && mi < 60 && s <= 60;
+}
+
+qint64 toMs(int y, int mo, int d, int h, int mi, int s, int ms) {
+    return ((daysFromCivil(y, unsigned(mo), unsigned(d)) * 24 + h) * 60 + mi) * 60000
+         + qint64(s) * 1000 + ms;
+}
+
+// .fff or ,fff (any number of digits, first three kept)
+int fraction(Cursor& c) {
+    if (!c.oneOf('.', ',')) return 0;
+    int ms = 0, n = 0;
+    for (int digit; c.digits(1, digit); ++n)
+        if (n < 3) ms = ms * 10 + digit;
+    for (; n < 3; ++n) ms *= 10;
+    return ms;
+}
+
+// Z, +HH:MM, +HHMM or +HH; stores the offset in ms, false if absent
+bool zoneOffset(Cursor& c, qint64& out) {
+    out = 0;
+    if (c.lit('Z')) return true;
+    const char sign = c.peek();
+    if (sign != '+' && sign != '-') return false;
+    c.skip();
+    int hh = 0, mm = 0;
+    if (!c.digits(2, hh)) return false;
+    c.lit(':');
+    c.digits(2, mm);
+    const qint64 off = (qint64(hh) * 60 + mm) * 60000;
+    out = sign == '+' ? off : -off;
+    return true;
+}
+
+// Offset of local time from UTC at the given instant, in ms
+qint64 localOffsetAt(qint64 utcMs) {
+    const std::time_t t = std::time_t(utcMs / 1000);
+    std::tm tm {};
+    localtime_r(&t, &tm);
+    return qint64(tm.tm_gmtoff) * 1000;
+}
+
+// Local wall-clock ms (as if UTC) to real UTC ms. Zone changes fall on
+// hour boundaries, so the offset is cached per wall-clock hour to keep the
+// localtime_r call off the per-line path.
+qint64 localToUtc(qint64 wallMs) {
+    constexpr qint64 kHourMs = 3600 * 1000;
+    thread_local qint64 cachedHour   = -1;
+    thread_local qint64 cachedOffset = 0;
+    const qint64 hour = wallMs / kHourMs;
+    if (hour != cachedHour) {
+        // Second pass settles the offset on the instant itself, not on the
+        // wall time read as UTC
+        const qint64 guess = localOffsetAt(wallMs);
+        cachedOffset = localOffsetAt(wallMs - guess);
+        cachedHour   = hour;
+    }
+    return wallMs - cachedOffset;
+}
+
+// Applies the zone offset that follows, or the local one if there is none
+qint64 toUtc(Cursor& c, qint64 wallMs) {
+    qint64 off;
+    return zoneOffset(c, off) ? wallMs - off : localToUtc(wallMs);
+}
+
+// 2026-10-14T12:00:00[.123][Z|±hh:mm]
+qint64 parseIso(const char* p, const char* end) {
+    Cursor c(p, end);
+    int y, mo, d, h, mi, s;
+    if (!c.digits(4, y) || !c.lit('-') || !c.digits(2, mo) || !c.lit('-') || !c.digits(2, d) ||
+        !c.oneOf('T', ' ') || !c.digits(2, h) || !c.lit(':') || !c.digits(2, mi) ||
+        !c.lit(':') || !c.digits(2, s) || !validTime(mo, d, h, mi, s))
+        return -1;
+    const int ms = fraction(c);
+    return toUtc(c, toMs(y, mo, d, h, mi, s, ms));
+}
+
+// Oct 14 12:00:00 (day may be space padded)
+qint64 parseSyslog(const char* p, const char* end) {
+    Cursor c(p, end);
+    int mo, d, h, mi, s;
+    if (!c.month(mo) || !c.lit(' ')) return -1;
+    c.lit(' ');
+    if (!c.digits(2, d) && !c.digits(1, d)) return -1;
+    if (!c.lit(' ') || !c.digits(2, h) || !c.lit(':') || !c.digits(2, mi) ||
+        !c.lit(':') || !c.digits(2, s) || !validTime(mo, d, h, mi, s))
+        return -1;
+
+    // Computed once; logs that span New Year will sort oddly for a moment
+    static const int kYear = [] {
+        const std::time_t now = std::time(nullptr);
+        std::tm tm {};
+        localtime_r(&now, &tm);
+        return tm.tm_year + 1900;
+    }();
+    return localToUtc(toMs(kYear, mo, d, h, mi, s, fraction(c)));
+}
+
+// 14/Oct/2026:12:00:00 +0000
+qint64 parseAccessLog(const char* p, const char* end) {
+    Cursor c(p, end);
+    int d, mo, y, h, mi, s;
+    if (!c.digits(2, d) || !c.lit('/') || !c.month(mo) || !c.lit('/') || !c.digits(4, y) ||
+        !c.lit(':') || !c.digits(2, h) || !c.lit(':') || !c.digits(2, mi) ||
+        !c.lit(':') || !c.digits(2, s) || !validTime(mo, d, h, mi, s))
+        return -1;
+    c.lit(' ');
+    return toUtc(c, toMs(y, mo, d, h, mi, s, 0));
+}
+
+qint64 parseAt(const char* p, const char* end) {
+    if (p == end) return -1;
+    if (*p >= '0' && *p <= '9') {
+        const qint64 ts = parseIso(p, end);
+        return ts >= 0 ? ts : parseAccessLog(p, end);
+    }
+    return parseSyslog(p, end);
+}
+
+}  // namespace
+
+qint64 parseTimestamp(QByteArrayView line) {
+    const char* p   = line.data();
+    const char* end = p + line.size();
+
+    const qint64 ts = parseAt(p, end);
+    if (ts >= 0) return ts;
+
+    // Otherwise try right after the first '[' near the start
+    const char* limit = p + qMin(line.size(), kSearchBytes);
+    for (const char* q = p; q < limit; ++q)
+        if (*q == '[') return parseAt(q + 1, end);
+    return -1;
+}
@@ -0,0 +1,28 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <QByteArrayView>
+
+// Parses a timestamp near the start of a log line and returns it as
+// milliseconds since the epoch, or -1 if none was recognised. Understands
+// ISO 8601 (2026-10-14T12:00:00.123+02:00, with 'T' or ' '), syslog
+// (Oct 14 12:00:00, current year assumed) and the common access-log form
+// ([14/Oct/2026:12:00:00 +0000]). Values without an explicit offset are
+// read as local time, so every result is real UTC and comparable with
+// QDateTime::currentMSecsSinceEpoch(). Never allocates.
+qint64 parseTimestamp(QByteArrayView line);
@@ -0,0 +1,295 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+// logtail-agent: runs on a remote host, started by the widget over ssh, and
+// streams the files it is asked to follow back over stdout as batched,
+// compressed frames (see RemoteProtocol.h). One agent serves every file the
+// dashboard follows on that host. Files are polled, which works the same on
+// every filesystem and keeps the agent a single small loop.
+//
+//   ssh host logtail-agent
+
+#include "RemoteProtocol.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int         kPollMs        = 100;
+constexpr std::size_t kChunkSize     = 256 * 1024;
+// Per stream and poll, so one busy file cannot starve the others
+constexpr std::size_t kBatchBytes    = 1024 * 1024;
+constexpr std::size_t kCompressAbove = 256;
+// Head of an overlong line that is kept, leaving room for the cut note
+constexpr std::size_t kKeepBytes     = remote::kMaxLine - 64;
+
+struct Stream {
+    std::uint16_t id       = 0;
+    std::string   path;
+    std::size_t   maxLines = 500;
+    int           fd       = -1;
+    std::uint64_t inode    = 0;
+    std::uint64_t pos      = 0;       // read position in fd
+    std::string   partial;            // bytes after the last '\n' read, capped
+    std::uint64_t cut      = 0;       // bytes of that line dropped past kKeepBytes
+    std::uint32_t seq      = 0;
+    std::uint16_t pending  = 0;       // flags for the next frame
+    bool          missing  = false;   // open failure already reported
+};
+
+std::map<std::uint16_t, Stream> streams;
+
+void writeAll(const void* data, std::size_t len) {
+    const char* p = static_cast<const char*>(data);
+    while (len > 0) {
+        const ssize_t n = ::write(STDOUT_FILENO, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) std::exit(0);   // the widget went away
+        p   += n;
+        len -= std::size_t(n);
+    }
+}
+
+void sendFrame(Stream& s, std::uint16_t flags, const std::string& raw) {
+    remote::FrameHeader h;
+    h.stream  = s.id;
+    h.flags   = std::uint16_t(flags | s.pending);
+    h.seq     = s.seq++;
+    h.rawSize = std::uint32_t(raw.size());
+    h.offset  = s.pos - s.partial.size() - s.cut;
+    h.inode   = s.inode;
+    s.pending = 0;
+
+    std::string payload;
+    if (raw.size() > kCompressAbove) {
+        uLongf size = compressBound(uLong(raw.size()));
+        payload.resize(size);
+        if (compress2(reinterpret_cast<Bytef*>(payload.data()), &size,
+                      reinterpret_cast<const Bytef*>(raw.data()), uLong(raw.size()),
+                      Z_BEST_SPEED) == Z_OK && size < raw.size()) {
+            payload.resize(size);
+            h.flags |= remote::kFlagCompressed;
+        } else {
+            payload.clear();
+        }
+    }
+    const std::string& body = (h.flags & remote::kFlagCompressed) ? payload : raw;
+    h.payloadSize = std::uint32_t(body.size());
+
+    unsigned char header[remote::kHeaderSize];
+    remote::encodeHeader(h, header);
+    writeAll(header, sizeof header);
+    writeAll(body.data(), body.size());
+}
+
+void sendError(Stream& s, const std::string& message) {
+    sendFrame(s, remote::kFlagError, message);
+}
+
+// Offset where the last `lines` lines of the file begin
+std::uint64_t tailStart(int fd, std::uint64_t size, std::size_t lines) {
+    std::vector<char> buf(64 * 1024);
+    std::uint64_t     pos   = size;
+    std::size_t       found = 0;
+    while (pos > 0) {
+        const std::size_t n = std::size_t(std::min<std::uint64_t>(buf.size(), pos));
+        pos -= n;
+        if (::pread(fd, buf.data(), n, off_t(pos)) != ssize_t(n)) return 0;
+        for (std::size_t i = n; i-- > 0; ) {
+            // The newline ending the last line does not start one
+            if (buf[i] != '\n' || pos + i == size - 1) continue;
+            if (++found == lines) return pos + i + 1;
+        }
+    }
+    return 0;
+}
+
+// Back to the start of the file, with no line in progress
+void rewind(Stream& s) {
+    s.pos = 0;
+    s.partial.clear();
+    s.cut = 0;
+}
+
+bool openStream(Stream& s) {
+    s.fd = ::open(s.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (s.fd < 0) {
+        if (!s.missing) sendError(s, "Cannot open: " + s.path + ": " + std::strerror(errno));
+        s.missing = true;
+        return false;
+    }
+    struct stat st {};
+    ::fstat(s.fd, &st);
+    s.inode   = std::uint64_t(st.st_ino);
+    s.missing = false;
+    rewind(s);
+    return true;
+}
+
+void closeStream(Stream& s) {
+    if (s.fd >= 0) ::close(s.fd);
+    s.fd = -1;
+}
+
+// Adds to the unfinished line, keeping only its head so a file without
+// newlines cannot make the agent grow without bound
+void extendPartial(Stream& s, const char* p, std::size_t len) {
+    if (s.cut > 0) {
+        s.cut += len;
+        return;
+    }
+    std::size_t take = std::min(len, kKeepBytes - std::min(s.partial.size(), kKeepBytes));
+    // Cut at a UTF-8 character boundary
+    if (take < len)
+        while (take > 0 && (static_cast<unsigned char>(p[take]) & 0xC0) == 0x80) --take;
+    s.partial.append(p, take);
+    s.cut = len - take;
+}
+
+void finishPartial(Stream& s, std::string& batch) {
+    batch += s.partial;
+    if (s.cut > 0) batch += " … [" + std::to_string(s.cut) + " bytes cut]";
+    batch += '\n';
+    s.partial.clear();
+    s.cut = 0;
+}
+
+// Reads what fd has beyond pos and sends the complete lines
+void drain(Stream& s, bool flushPartial) {
+    std::string       batch;
+    std::vector<char> buf(kChunkSize);
+    while (batch.size() < kBatchBytes) {
+        const ssize_t n = ::pread(s.fd, buf.data(), buf.size(), off_t(s.pos));
+        if (n <= 0) break;
+        s.pos += std::uint64_t(n);
+        const char* p   = buf.data();
+        const char* end = p + n;
+        while (p < end) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', std::size_t(end - p)));
+            const std::size_t len = std::size_t((nl ? nl : end) - p);
+            if (nl && s.partial.empty() && s.cut == 0 && len <= kKeepBytes) {
+                batch.append(p, len + 1);   // the common case, copied once
+            } else {
+                extendPartial(s, p, len);
+                if (!nl) break;
+                finishPartial(s, batch);
+            }
+            p += len + 1;
+        }
+    }
+    if (flushPartial && (!s.partial.empty() || s.cut > 0)) finishPartial(s, batch);
+    // No frame for an idle poll, except to deliver pending flags (an empty seed)
+    if (!batch.empty() || s.pending) sendFrame(s, 0, batch);
+}
+
+void pump(Stream& s) {
+    if (s.fd < 0 && !openStream(s)) return;
+
+    struct stat st {};
+    if (::stat(s.path.c_str(), &st) == 0 && std::uint64_t(st.st_ino) != s.inode) {
+        // Rotated: finish the old file, then follow the new one from its start
+        drain(s, true);
+        closeStream(s);
+        if (!openStream(s)) return;
+        s.pending |= remote::kFlagRotated;
+    } else if (::fstat(s.fd, &st) == 0 && std::uint64_t(st.st_size) < s.pos) {
+        // Truncated in place
+        rewind(s);
+        s.pending |= remote::kFlagRotated;
+    }
+    drain(s, false);
+}
+
+void startTail(std::uint16_t id, std::size_t maxLines, std::uint64_t inode,
+               std::uint64_t offset, const std::string& path) {
+    Stream& s = streams[id];
+    closeStream(s);
+    s = Stream{};
+    s.id       = id;
+    s.path     = path;
+    s.maxLines = maxLines > 0 ? maxLines : 1;
+    if (!openStream(s)) return;
+
+    struct stat st {};
+    ::fstat(s.fd, &st);
+    const std::uint64_t size = std::uint64_t(st.st_size);
+    if (inode != 0 && inode == s.inode && offset <= size) {
+        s.pos = offset;   // same file, still that long: carry on where we were
+    } else {
+        s.pos     = tailStart(s.fd, size, s.maxLines);
+        s.pending = remote::kFlagSeed;
+    }
+    drain(s, false);
+}
+
+void command(const std::string& line) {
+    std::istringstream in(line);
+    std::string        verb;
+    in >> verb;
+    if (verb == "tail") {
+        unsigned      id = 0;
+        std::size_t   maxLines = 0;
+        std::uint64_t inode = 0, offset = 0;
+        std::string   path;
+        in >> id >> maxLines >> inode >> offset >> std::ws;
+        std::getline(in, path);
+        if (!path.empty()) startTail(std::uint16_t(id), maxLines, inode, offset, path);
+    } else if (verb == "drop") {
+        unsigned id = 0;
+        in >> id;
+        if (auto it = streams.find(std::uint16_t(id)); it != streams.end()) {
+            closeStream(it->second);
+            streams.erase(it);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::string input;
+    char        buf[4096];
+    while (true) {
+        pollfd p {STDIN_FILENO, POLLIN, 0};
+        if (::poll(&p, 1, kPollMs) > 0) {
+            const ssize_t n = ::read(STDIN_FILENO, buf, sizeof buf);
+            if (n == 0) return 0;   // ssh closed: the widget is gone
+            if (n > 0) input.append(buf, std::size_t(n));
+            for (std::size_t nl; (nl = input.find('\n')) != std::string::npos; ) {
+                command(input.substr(0, nl));
+                input.erase(0, nl + 1);
+            }
+        }
+        for (auto& [id, s] : streams) pump(s);
+    }
+}
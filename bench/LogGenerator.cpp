@@ -0,0 +1,111 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "LogGenerator.h"
+
+#include "IngestMetrics.h"
+
+#include <QRegularExpression>
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+// Roughly what a chatty service emits: mostly info, some debug, few problems
+struct Level {
+    const char* text;
+    int         weight;
+};
+constexpr Level kLevels[] = {
+    {"INFO",  70}, {"DEBUG", 18}, {"WARN", 7}, {"ERROR", 3}, {"", 2},
+};
+
+constexpr int kMaxPayload = 64 * 1024;
+
+}  // namespace
+
+bool LogGenerator::parseLengths(const QString& spec, Lengths& out) {
+    static const QRegularExpression fixed(R"(^fixed:(\d+)$)");
+    static const QRegularExpression uniform(R"(^uniform:(\d+)-(\d+)$)");
+    static const QRegularExpression lognormal(R"(^lognormal:(\d+),([\d.]+)$)");
+
+    if (const auto m = fixed.match(spec); m.hasMatch()) {
+        out = {Shape::Fixed, m.captured(1).toInt(), 0};
+    } else if (const auto m = uniform.match(spec); m.hasMatch()) {
+        out = {Shape::Uniform, m.captured(1).toInt(), m.captured(2).toDouble()};
+        if (out.b < out.a) return false;
+    } else if (const auto m = lognormal.match(spec); m.hasMatch()) {
+        out = {Shape::LogNormal, m.captured(1).toInt(), m.captured(2).toDouble()};
+    } else {
+        return false;
+    }
+    return out.a >= 0;
+}
+
+LogGenerator::LogGenerator(const Lengths& lengths, quint32 seed)
+    : lengths_(lengths), rng_(seed) {
+    static const char kWords[] =
+        "request served user session cache miss upstream timeout retry connection "
+        "queue flushed handler worker shard replica commit checkpoint latency ";
+    filler_.reserve(kMaxPayload * 2);
+    while (filler_.size() < kMaxPayload * 2) filler_.append(kWords);
+}
+
+int LogGenerator::payloadLength() {
+    double len = lengths_.a;
+    switch (lengths_.shape) {
+        case Shape::Fixed:
+            break;
+        case Shape::Uniform:
+            len = std::uniform_int_distribution<int>(lengths_.a, int(lengths_.b))(rng_);
+            break;
+        case Shape::LogNormal:
+            len = std::lognormal_distribution<double>(std::log(double(qMax(1, lengths_.a))),
+                                                      lengths_.b)(rng_);
+            break;
+    }
+    return int(qBound(0.0, len, double(kMaxPayload)));
+}
+
+void LogGenerator::appendLine(QByteArray& out) {
+    // One fixed day is enough for lines that only need to parse
+    clockMs_ = (clockMs_ + std::uniform_int_distribution<int>(0, 7)(rng_)) % 86'400'000;
+    char stamp[32];
+    std::snprintf(stamp, sizeof stamp, "2026-10-14T%02d:%02d:%02d.%03d",
+                  int(clockMs_ / 3'600'000), int(clockMs_ / 60'000 % 60),
+                  int(clockMs_ / 1000 % 60), int(clockMs_ % 1000));
+    out.append(stamp);
+    out.append(" bench-host app[4242]: ");
+
+    int pick = std::uniform_int_distribution<int>(0, 99)(rng_);
+    for (const Level& level : kLevels) {
+        if ((pick -= level.weight) < 0) {
+            if (*level.text) out.append(level.text).append(' ');
+            break;
+        }
+    }
+
+    out.append("t=").append(QByteArray::number(monotonicNs())).append(' ');
+    const int len   = payloadLength();
+    const int start = std::uniform_int_distribution<int>(0, kMaxPayload - 1)(rng_);
+    out.append(filler_.constData() + start, len);
+    out.append('\n');
+}
+
+void LogGenerator::appendLines(QByteArray& out, qint64 n) {
+    for (qint64 i = 0; i < n; ++i) appendLine(out);
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <random>
+
+// Synthetic log lines for logtail-bench. Each line looks like real output,
+// "2026-10-14T12:00:00.123 host app[1234]: LEVEL t=<ns> payload", with a
+// payload length drawn from a configurable distribution and a severity
+// keyword mix close to a busy service. t= carries monotonicNs() at
+// generation so the receiving end can measure latency.
+class LogGenerator {
+public:
+    enum class Shape { Fixed, Uniform, LogNormal };
+
+    struct Lengths {
+        Shape  shape = Shape::LogNormal;
+        int    a     = 120;   // fixed length, uniform min, or log-normal median
+        double b     = 0.6;   // uniform max, or log-normal sigma
+    };
+
+    // Parses "fixed:120", "uniform:20-400" or "lognormal:120,0.6".
+    static bool parseLengths(const QString& spec, Lengths& out);
+
+    explicit LogGenerator(const Lengths& lengths, quint32 seed = 1);
+
+    // Appends one line, newline included, to `out`.
+    void appendLine(QByteArray& out);
+    // Appends `n` lines.
+    void appendLines(QByteArray& out, qint64 n);
+
+private:
+    int payloadLength();
+
+    Lengths            lengths_;
+    std::mt19937       rng_;
+    qint64             clockMs_ = 0;   // fake time of day for the timestamps
+    QByteArray         filler_;        // payload text, sliced per line
+};
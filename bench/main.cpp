@@ -0,0 +1,403 @@
+// Copyright (C) 2026 Sean Moon
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+// logtail-bench: drives the ingestion pipeline headlessly against synthetic
+// logs and reports throughput and latency, so changes to scanning,
+// classification, filtering, the line store or the readers can be measured.
+//
+//   logtail-bench [--case all|scan|classify|filter|store|seed|file|pipe]
+//                 [--lengths lognormal:120,0.6] [--size-mb 64] [--rate 20000]
+//                 [--seconds 5] [--max-lines 5000] [--flush-ms 50]
+
+#include "LogGenerator.h"
+
+#include "IngestMetrics.h"
+#include "LineBatch.h"
+#include "LineFilter.h"
+#include "LineScanner.h"
+#include "LineStore.h"
+#include "Severity.h"
+#include "TailSource.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFile>
+#include <QSocketNotifier>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Options {
+    LogGenerator::Lengths lengths;
+    qint64                sizeMb   = 64;
+    int                   rate     = 20'000;   // lines per second for file and pipe
+    int                   seconds  = 5;
+    int                   maxLines = 5000;
+    int                   flushMs  = 50;
+};
+
+struct Result {
+    double              linesPerSec = 0;
+    double              mbPerSec    = 0;
+    std::vector<qint64> latencyNs;
+};
+
+constexpr qsizetype kChunk = 64 * 1024;   // FileTailWorker's read size
+
+double percentileUs(std::vector<qint64>& v, double p) {
+    if (v.empty()) return -1;
+    const size_t i = size_t(p * double(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + qint64(i), v.end());
+    return double(v[i]) / 1e3;
+}
+
+void report(const char* name, Result r) {
+    const double p50 = percentileUs(r.latencyNs, 0.50);
+    const double p99 = percentileUs(r.latencyNs, 0.99);
+    std::printf("%-10s %14.0f %10.1f", name, r.linesPerSec, r.mbPerSec);
+    if (p50 >= 0) std::printf(" %12.0f %12.0f\n", p50, p99);
+    else          std::printf(" %12s %12s\n", "-", "-");
+    std::fflush(stdout);
+}
+
+// Latency from the t=<ns> stamp LogGenerator put in the line
+qint64 latencyOf(QByteArrayView line, qint64 now) {
+    const qsizetype at = line.indexOf("t=");
+    if (at < 0) return -1;
+    qint64 ns = 0;
+    for (qsizetype i = at + 2; i < line.size() && line[i] >= '0' && line[i] <= '9'; ++i)
+        ns = ns * 10 + (line[i] - '0');
+    return ns > 0 ? now - ns : -1;
+}
+
+// Records the latency of every row appended to `store` since the last call
+void collect(const LineStore& store, qint64& seen, std::vector<qint64>& out) {
+    const qint64 now   = monotonicNs();
+    const qint64 total = store.evicted() + store.size();
+    for (qint64 id = qMax(seen, store.evicted()); id < total; ++id) {
+        const qint64 ns = latencyOf(store.line(qsizetype(id - store.evicted())), now);
+        if (ns >= 0) out.push_back(ns);
+    }
+    seen = total;
+}
+
+// Runs `work` until at least a second has passed; returns iterations and time
+template <typename F>
+std::pair<qint64, double> repeat(F&& work) {
+    const qint64 t0 = monotonicNs();
+    qint64 n = 0;
+    do { work(); ++n; } while (monotonicNs() - t0 < 1'000'000'000);
+    return {n, double(monotonicNs() - t0) / 1e9};
+}
+
+// ── In-memory stages ──────────────────────────────────────────────────────────
+
+struct Corpus {
+    QByteArray              data;
+    std::vector<LineRecord> records;
+};
+
+Corpus makeCorpus(const Options& opt) {
+    Corpus c;
+    LogGenerator gen(opt.lengths);
+    while (c.data.size() < opt.sizeMb * 1024 * 1024) gen.appendLines(c.data, 1000);
+    scanLines(c.data.constData(), c.data.size(), c.records);
+    return c;
+}
+
+Result benchScan(const Corpus& c) {
+    std::vector<LineRecord> records;
+    const auto [n, secs] = repeat([&] {
+        for (qsizetype at = 0; at < c.data.size(); at += kChunk) {
+            records.clear();
+            scanLines(c.data.constData() + at, qMin(kChunk, c.data.size() - at), records);
+        }
+    });
+    return {double(n) * double(c.records.size()) / secs,
+            double(n) * double(c.data.size()) / secs / 1e6, {}};
+}
+
+Result benchClassify(const Corpus& c) {
+    int sink = 0;
+    const auto [n, secs] = repeat([&] {
+        for (const LineRecord& r : c.records)
+            sink += int(classifyLine(QByteArrayView(c.data.constData() + r.offset, r.length)));
+    });
+    if (sink == -1) std::puts("");   // keeps the loop from being optimised away
+    return {double(n) * double(c.records.size()) / secs,
+            double(n) * double(c.data.size()) / secs / 1e6, {}};
+}
+
+Result benchFilter(const Corpus& c) {
+    const LineFilter filter({.pattern = "timeout"});
+    qint64 hits = 0;
+    const auto [n, secs] = repeat([&] {
+        for (const LineRecord& r : c.records)
+            hits += filter.accepts(QByteArrayView(c.data.constData() + r.offset, r.length),
+                                   r.severity);
+    });
+    if (hits == -1) std::puts("");
+    return {double(n) * double(c.records.size()) / secs,
+            double(n) * double(c.data.size()) / secs / 1e6, {}};
+}
+
+Result benchStore(const Corpus& c, const Options& opt) {
+    LineStore store(opt.maxLines);
+    const auto [n, secs] = repeat([&] {
+        for (const LineRecord& r : c.records)
+            store.append(QByteArrayView(c.data.constData() + r.offset, r.length), r.severity);
+    });
+    return {double(n) * double(c.records.size()) / secs,
+            double(n) * double(c.data.size()) / secs / 1e6, {}};
+}
+
+// ── Readers ───────────────────────────────────────────────────────────────────
+
+// Appends generated lines to fd at `rate` lines per second for `seconds`
+void writeAtRate(int fd, const Options& opt, std::atomic<bool>& done) {
+    LogGenerator gen(opt.lengths, 2);
+    QByteArray   buf;
+    const qint64 t0      = monotonicNs();
+    const qint64 end     = t0 + qint64(opt.seconds) * 1'000'000'000;
+    qint64       written = 0;
+    for (qint64 now = t0; now < end; now = monotonicNs()) {
+        const qint64 due = qint64(double(now - t0) / 1e9 * opt.rate);
+        buf.clear();
+        gen.appendLines(buf, due - written);
+        written = due;
+        for (qsizetype off = 0; off < buf.size(); ) {
+            const ssize_t n = ::write(fd, buf.constData() + off, size_t(buf.size() - off));
+            if (n <= 0) break;
+            off += n;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    done = true;
+}
+
+// Time from acquiring a source on an existing file to its first lines
+Result benchSeed(const Options& opt, const QString& dir) {
+    const QString path = dir + "/seed.log";
+    {
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly)) return {};
+        LogGenerator gen(opt.lengths, 3);
+        QByteArray   buf;
+        for (qint64 size = 0; size < opt.sizeMb * 1024 * 1024; size += buf.size()) {
+            buf.clear();
+            gen.appendLines(buf, 1000);
+            f.write(buf);
+        }
+    }
+
+    LogTailConfig config;
+    config.source   = LogTailConfig::Source::File;
+    config.filePath = path;
+
+    Result r;
+    for (int run = 0; run < 10; ++run) {
+        const qint64 t0 = monotonicNs();
+        QEventLoop   loop;
+        auto source = TailSource::acquire(config);
+        QObject::connect(source.get(), &TailSource::appended, &loop, &QEventLoop::quit);
+        QObject viewer;
+        source->addViewer(&viewer, opt.maxLines, opt.flushMs);
+        QTimer::singleShot(30'000, &loop, &QEventLoop::quit);
+        loop.exec();
+        // The flush interval is a deliberate delay, not seeding cost
+        r.latencyNs.push_back(monotonicNs() - t0 - qint64(opt.flushMs) * 1'000'000);
+        source->removeViewer(&viewer);
+    }
+    // Seeding reads only the tail, so lines delivered per second of the fastest run
+    r.linesPerSec = double(opt.maxLines) * 1e9 /
+                    double(qMax<qint64>(1, *std::min_element(r.latencyNs.begin(), r.latencyNs.end())));
+    return r;
+}
+
+// The whole file path: inotify, reader thread, flush timer and line store
+Result benchFile(const Options& opt, const QString& dir) {
+    const QString path = dir + "/tail.log";
+    QFile::remove(path);
+    const int fd = ::open(QFile::encodeName(path).constData(),
+                          O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) return {};
+
+    LogTailConfig config;
+    config.source   = LogTailConfig::Source::File;
+    config.filePath = path;
+    auto    source = TailSource::acquire(config);
+    QObject viewer;
+    source->addViewer(&viewer, opt.maxLines, opt.flushMs);
+
+    Result r;
+    qint64 seen = 0;
+    QObject::connect(source.get(), &TailSource::appended, [&] {
+        collect(source->store(), seen, r.latencyNs);
+    });
+
+    std::atomic<bool> done {false};
+    const qint64 t0 = monotonicNs();
+    std::thread writer(writeAtRate, fd, std::cref(opt), std::ref(done));
+
+    QEventLoop loop;
+    QTimer     poll;
+    QObject::connect(&poll, &QTimer::timeout, &loop, [&] { if (done) loop.quit(); });
+    poll.start(10);
+    loop.exec();
+    writer.join();
+    ::close(fd);
+
+    // Let the last batches through
+    QTimer::singleShot(qMax(200, 4 * opt.flushMs), &loop, &QEventLoop::quit);
+    loop.exec();
+
+    const IngestCounters& c = source->counters();
+    const double secs = double(monotonicNs() - t0) / 1e9;
+    r.linesPerSec = double(c.lines.load()) / secs;
+    r.mbPerSec    = double(c.bytes.load()) / secs / 1e6;
+    source->removeViewer(&viewer);
+    return r;
+}
+
+// Journal-like input: lines arrive on a pipe and are split, classified and
+// batched on the GUI thread, as with the journalctl fallback
+Result benchPipe(const Options& opt) {
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0) return {};
+    ::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+    LineStore               store(opt.maxLines);
+    LineBatch               pending;
+    QByteArray              partial;
+    std::vector<LineRecord> records;
+    Result                  r;
+    qint64                  seen = 0, lines = 0, bytes = 0;
+
+    QTimer flush;
+    flush.setSingleShot(true);
+    QObject::connect(&flush, &QTimer::timeout, [&] {
+        store.append(std::exchange(pending, {}));
+        collect(store, seen, r.latencyNs);
+    });
+
+    QSocketNotifier notifier(fds[0], QSocketNotifier::Read);
+    QObject::connect(&notifier, &QSocketNotifier::activated, [&] {
+        char buf[kChunk];
+        ssize_t n;
+        while ((n = ::read(fds[0], buf, sizeof buf)) > 0) {
+            partial.append(buf, n);
+            records.clear();
+            const qsizetype tail = scanLines(partial.constData(), partial.size(), records);
+            for (const LineRecord& rec : records) {
+                if (rec.length == 0) continue;
+                pending.append(QByteArrayView(partial.constData() + rec.offset, rec.length),
+                               rec.severity);
+                ++lines;
+            }
+            bytes += tail;
+            partial.remove(0, tail);
+        }
+        pending.keepLast(opt.maxLines);
+        if (!flush.isActive()) flush.start(opt.flushMs);
+    });
+
+    std::atomic<bool> done {false};
+    const qint64 t0 = monotonicNs();
+    std::thread writer(writeAtRate, fds[1], std::cref(opt), std::ref(done));
+
+    QEventLoop loop;
+    QTimer     poll;
+    QObject::connect(&poll, &QTimer::timeout, &loop, [&] { if (done) loop.quit(); });
+    poll.start(10);
+    loop.exec();
+    writer.join();
+    QTimer::singleShot(qMax(200, 4 * opt.flushMs), &loop, &QEventLoop::quit);
+    loop.exec();
+    ::close(fds[1]);
+    ::close(fds[0]);
+
+    const double secs = double(monotonicNs() - t0) / 1e9;
+    r.linesPerSec = double(lines) / secs;
+    r.mbPerSec    = double(bytes) / secs / 1e6;
+    return r;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("logtail-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks the logtail ingestion pipeline.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"case",      "scan, classify, filter, store, seed, file, pipe or all.", "name", "all"},
+        {"lengths",   "Payload lengths: fixed:N, uniform:MIN-MAX or lognormal:MEDIAN,SIGMA.",
+                      "spec", "lognormal:120,0.6"},
+        {"size-mb",   "Corpus and seed file size.", "mb", "64"},
+        {"rate",      "Lines per second written in the file and pipe cases.", "n", "20000"},
+        {"seconds",   "Duration of the file and pipe cases.", "s", "5"},
+        {"max-lines", "Line buffer size.", "n", "5000"},
+        {"flush-ms",  "Flush interval.", "ms", "50"},
+    });
+    parser.process(app);
+
+    Options opt;
+    if (!LogGenerator::parseLengths(parser.value("lengths"), opt.lengths)) {
+        std::fprintf(stderr, "bad --lengths: %s\n", qPrintable(parser.value("lengths")));
+        return 2;
+    }
+    opt.sizeMb   = qMax(1, parser.value("size-mb").toInt());
+    opt.rate     = qMax(1, parser.value("rate").toInt());
+    opt.seconds  = qMax(1, parser.value("seconds").toInt());
+    opt.maxLines = qMax(1, parser.value("max-lines").toInt());
+    opt.flushMs  = qMax(1, parser.value("flush-ms").toInt());
+
+    const QString which = parser.value("case");
+    const auto    wants = [&](const char* name) { return which == "all" || which == name; };
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        std::fprintf(stderr, "cannot create a temporary directory\n");
+        return 1;
+    }
+
+    std::printf("%-10s %14s %10s %12s %12s\n", "case", "lines/s", "MB/s", "p50 µs", "p99 µs");
+    if (wants("scan") || wants("classify") || wants("filter") || wants("store")) {
+        const Corpus corpus = makeCorpus(opt);
+        if (wants("scan"))     report("scan",     benchScan(corpus));
+        if (wants("classify")) report("classify", benchClassify(corpus));
+        if (wants("filter"))   report("filter",   benchFilter(corpus));
+        if (wants("store"))    report("store",    benchStore(corpus, opt));
+    }
+    if (wants("seed")) report("seed", benchSeed(opt, dir.path()));
+    if (wants("file")) report("file", benchFile(opt, dir.path()));
+    if (wants("pipe")) report("pipe", benchPipe(opt));
+    return 0;
+}